@@ -0,0 +1,145 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cbarroso/mpmcqueue.h>
+#include <cbarroso/queue.h>
+
+#define JOBS 4000000
+
+/* Runs N producers and N consumers over an MpmcQueue and over a Queue
+behind a mutex, as a worker pool job queue */
+
+typedef struct LockedQueue
+{
+    pthread_mutex_t mutex;
+    Queue *queue;
+} LockedQueue;
+
+typedef struct Worker
+{
+    void *queue;
+    int64_t jobs;
+} Worker;
+
+static void *sMpmcProducer(void *argument)
+{
+    Worker *worker = argument;
+
+    for (int64_t job = 0; job < worker->jobs; job++)
+    {
+        MpmcQueue__enqueue(worker->queue, &job);
+    }
+
+    return NULL;
+}
+
+static void *sMpmcConsumer(void *argument)
+{
+    Worker *worker = argument;
+    int64_t job;
+
+    for (int64_t i = 0; i < worker->jobs; i++)
+    {
+        MpmcQueue__dequeue(worker->queue, &job);
+    }
+
+    return NULL;
+}
+
+static void *sLockedProducer(void *argument)
+{
+    Worker *worker = argument;
+    LockedQueue *locked = worker->queue;
+
+    for (int64_t job = 0; job < worker->jobs; job++)
+    {
+        pthread_mutex_lock(&locked->mutex);
+        Queue__enqueue(locked->queue, &job, sizeof(int64_t));
+        pthread_mutex_unlock(&locked->mutex);
+    }
+
+    return NULL;
+}
+
+static void *sLockedConsumer(void *argument)
+{
+    Worker *worker = argument;
+    LockedQueue *locked = worker->queue;
+    int64_t job;
+
+    for (int64_t i = 0; i < worker->jobs;)
+    {
+        pthread_mutex_lock(&locked->mutex);
+
+        if (locked->queue->numberOfNodes > 0)
+        {
+            Queue__dequeueInto(locked->queue, &job, sizeof(int64_t), NULL);
+            i++;
+            pthread_mutex_unlock(&locked->mutex);
+        }
+        else
+        {
+            pthread_mutex_unlock(&locked->mutex);
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static double sRun(void *(*producer)(void *), void *(*consumer)(void *), void *queue, int pairs)
+{
+    pthread_t threads[128];
+    Worker worker = {queue, JOBS / pairs};
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int t = 0; t < pairs; t++)
+    {
+        pthread_create(&threads[2 * t], NULL, producer, &worker);
+        pthread_create(&threads[2 * t + 1], NULL, consumer, &worker);
+    }
+
+    for (int t = 0; t < 2 * pairs; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec)) /
+           (double)(worker.jobs * pairs);
+}
+
+int main(int argc, char **argv)
+{
+    int maxPairs = argc > 1 ? atoi(argv[1]) : 32;
+
+    if (maxPairs < 1 || maxPairs > 64)
+    {
+        fprintf(stderr, "Usage: %s [producer/consumer pairs (1-64)]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%8s %14s %14s\n", "pairs", "mpmc ns/job", "mutex ns/job");
+
+    for (int pairs = 1; pairs <= maxPairs; pairs *= 2)
+    {
+        MpmcQueue *mpmc = MpmcQueue__new(sizeof(int64_t), 1024);
+        LockedQueue locked = {PTHREAD_MUTEX_INITIALIZER, Queue__new()};
+
+        double mpmcTime = sRun(sMpmcProducer, sMpmcConsumer, mpmc, pairs);
+        double lockedTime = sRun(sLockedProducer, sLockedConsumer, &locked, pairs);
+
+        printf("%8d %14.1f %14.1f\n", pairs, mpmcTime, lockedTime);
+
+        MpmcQueue__del(mpmc);
+        Queue__del(locked.queue);
+    }
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cbarroso/priorityqueue.h>
+
+#define OPERATIONS 1000000
+
+/* Runs a scheduler loop keeping a fixed number of pending deadlines: each
+step takes the earliest one and schedules a new one further out. Compares a
+PriorityQueue against the sorted linked list it replaces, whose nodes are
+recycled so only the ordering costs are measured */
+
+typedef struct ListNode
+{
+    uint64_t deadline;
+    struct ListNode *next;
+} ListNode;
+
+/* Keeps the compiler from dropping the pops */
+static volatile uint64_t sChecksum;
+
+static uint64_t sNext(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+static int sCompareDeadlines(const void *left, const void *right, void *context)
+{
+    (void)context;
+    uint64_t a = *(const uint64_t *)left;
+    uint64_t b = *(const uint64_t *)right;
+
+    return (a > b) - (a < b);
+}
+
+static double sSince(struct timespec *start)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec)) / OPERATIONS;
+}
+
+static void sInsertSorted(ListNode **head, ListNode *node)
+{
+    ListNode **link = head;
+
+    while (*link != NULL && (*link)->deadline <= node->deadline)
+    {
+        link = &(*link)->next;
+    }
+
+    node->next = *link;
+    *link = node;
+}
+
+static double sRunSortedList(size_t pending)
+{
+    ListNode *nodes = malloc(pending * sizeof(ListNode));
+    ListNode *head = NULL;
+    uint64_t state = 88172645463325252ULL;
+    uint64_t checksum = 0;
+    struct timespec start;
+
+    for (size_t i = 0; i < pending; i++)
+    {
+        nodes[i].deadline = sNext(&state) % (pending * 16);
+        sInsertSorted(&head, &nodes[i]);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < OPERATIONS; i++)
+    {
+        ListNode *node = head;
+        head = node->next;
+        checksum += node->deadline;
+        node->deadline += 1 + sNext(&state) % (pending * 16);
+        sInsertSorted(&head, node);
+    }
+
+    double nanoseconds = sSince(&start);
+    sChecksum = checksum;
+    free(nodes);
+
+    return nanoseconds;
+}
+
+static double sRunPriorityQueue(size_t pending, size_t arity)
+{
+    PriorityQueue *queue = PriorityQueue__new(sizeof(uint64_t), arity, sCompareDeadlines, NULL);
+    uint64_t state = 88172645463325252ULL;
+    uint64_t checksum = 0;
+    uint64_t deadline;
+    struct timespec start;
+
+    for (size_t i = 0; i < pending; i++)
+    {
+        deadline = sNext(&state) % (pending * 16);
+        PriorityQueue__push(queue, &deadline);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < OPERATIONS; i++)
+    {
+        PriorityQueue__pop(queue, &deadline);
+        checksum += deadline;
+        deadline += 1 + sNext(&state) % (pending * 16);
+        PriorityQueue__push(queue, &deadline);
+    }
+
+    double nanoseconds = sSince(&start);
+    sChecksum = checksum;
+    PriorityQueue__del(queue);
+
+    return nanoseconds;
+}
+
+int main(void)
+{
+    size_t pendings[3] = {16, 256, 4096};
+
+    printf("%10s %14s %14s %14s\n", "pending", "sorted list", "binary heap", "4-ary heap");
+
+    for (int i = 0; i < 3; i++)
+    {
+        printf("%10zu %11.1f ns %11.1f ns %11.1f ns\n",
+               pendings[i],
+               sRunSortedList(pendings[i]),
+               sRunPriorityQueue(pendings[i], 2),
+               sRunPriorityQueue(pendings[i], 4));
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <cbarroso/chunkedqueue.h>
+#include <cbarroso/queue.h>
+#include <cbarroso/ringqueue.h>
+
+#define MESSAGES 10000000
+#define BACKLOG 64
+
+/* Moves small messages through a Queue, a RingQueue and a ChunkedQueue on
+one thread, keeping a short backlog as an event loop would */
+
+typedef struct Message
+{
+    int64_t id;
+    int64_t payload;
+} Message;
+
+/* Keeps the compiler from dropping the dequeues */
+static volatile int64_t sChecksum;
+
+static double sElapsed(struct timespec *start)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (double)(end.tv_sec - start->tv_sec) + (double)(end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static double sRunQueue(void)
+{
+    Queue *queue = Queue__new();
+    Message message = {0, 0};
+    struct timespec start;
+    int64_t checksum = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int64_t i = 0; i < MESSAGES; i++)
+    {
+        message.id = i;
+        Queue__enqueue(queue, &message, sizeof(Message));
+
+        if (queue->numberOfNodes > BACKLOG)
+        {
+            Queue__dequeueInto(queue, &message, sizeof(Message), NULL);
+            checksum += message.id;
+        }
+    }
+
+    double seconds = sElapsed(&start);
+    Queue__del(queue);
+    sChecksum = checksum;
+
+    return MESSAGES / seconds / 1e6;
+}
+
+static double sRunRingQueue(void)
+{
+    RingQueue *queue = RingQueue__new(sizeof(Message), BACKLOG);
+    Message message = {0, 0};
+    struct timespec start;
+    int64_t checksum = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int64_t i = 0; i < MESSAGES; i++)
+    {
+        message.id = i;
+        RingQueue__enqueue(queue, &message);
+
+        if (queue->numberOfElements > BACKLOG)
+        {
+            RingQueue__dequeue(queue, &message);
+            checksum += message.id;
+        }
+    }
+
+    double seconds = sElapsed(&start);
+    RingQueue__del(queue);
+    sChecksum = checksum;
+
+    return MESSAGES / seconds / 1e6;
+}
+
+static double sRunChunkedQueue(void)
+{
+    ChunkedQueue *queue = ChunkedQueue__new(sizeof(Message));
+    Message message = {0, 0};
+    struct timespec start;
+    int64_t checksum = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int64_t i = 0; i < MESSAGES; i++)
+    {
+        message.id = i;
+        ChunkedQueue__enqueue(queue, &message);
+
+        if (queue->numberOfElements > BACKLOG)
+        {
+            ChunkedQueue__dequeue(queue, &message);
+            checksum += message.id;
+        }
+    }
+
+    double seconds = sElapsed(&start);
+    ChunkedQueue__del(queue);
+    sChecksum = checksum;
+
+    return MESSAGES / seconds / 1e6;
+}
+
+int main(void)
+{
+    printf("%12s %14s\n", "queue", "Mmsg/s");
+    printf("%12s %14.1f\n", "Queue", sRunQueue());
+    printf("%12s %14.1f\n", "RingQueue", sRunRingQueue());
+    printf("%12s %14.1f\n", "ChunkedQueue", sRunChunkedQueue());
+
+    return 0;
+}
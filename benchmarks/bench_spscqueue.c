@@ -0,0 +1,170 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <cbarroso/queue.h>
+#include <cbarroso/spscqueue.h>
+
+#define MESSAGES 10000000
+#define BATCH 32
+
+/* Hands 8-byte messages from a producer thread to a consumer thread through
+an SpscQueue, one at a time and in batches, and through a Queue behind a
+mutex. A side that cannot progress yields, so the numbers stay meaningful
+when both threads share a core, but pinning them to two cores is what the
+SPSC queue is built for */
+
+typedef struct LockedQueue
+{
+    pthread_mutex_t mutex;
+    Queue *queue;
+} LockedQueue;
+
+static volatile int64_t sChecksum;
+
+static void *sSpscProducer(void *argument)
+{
+    for (int64_t i = 0; i < MESSAGES;)
+    {
+        if (SpscQueue__enqueue(argument, &i) == 0)
+        {
+            i++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *sSpscBatchProducer(void *argument)
+{
+    int64_t values[BATCH];
+
+    for (int64_t i = 0; i < MESSAGES;)
+    {
+        for (int j = 0; j < BATCH; j++)
+        {
+            values[j] = i + j;
+        }
+
+        size_t count = SpscQueue__enqueueBatch(argument, values, MESSAGES - i < BATCH ? (size_t)(MESSAGES - i) : BATCH);
+
+        if (count == 0)
+        {
+            sched_yield();
+        }
+
+        i += (int64_t)count;
+    }
+
+    return NULL;
+}
+
+static void *sLockedProducer(void *argument)
+{
+    LockedQueue *locked = argument;
+
+    for (int64_t i = 0; i < MESSAGES; i++)
+    {
+        pthread_mutex_lock(&locked->mutex);
+        Queue__enqueue(locked->queue, &i, sizeof(int64_t));
+        pthread_mutex_unlock(&locked->mutex);
+    }
+
+    return NULL;
+}
+
+static double sSince(struct timespec *start)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec)) / MESSAGES;
+}
+
+static double sRunSpsc(void *(*producer)(void *), size_t batch)
+{
+    SpscQueue *queue = SpscQueue__new(sizeof(int64_t), 1024);
+    int64_t values[BATCH];
+    int64_t checksum = 0;
+    pthread_t thread;
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&thread, NULL, producer, queue);
+
+    for (int64_t received = 0; received < MESSAGES;)
+    {
+        size_t count = SpscQueue__dequeueBatch(queue, values, batch);
+
+        if (count == 0)
+        {
+            sched_yield();
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            checksum += values[i];
+        }
+
+        received += (int64_t)count;
+    }
+
+    pthread_join(thread, NULL);
+    double nanoseconds = sSince(&start);
+    sChecksum = checksum;
+    SpscQueue__del(queue);
+
+    return nanoseconds;
+}
+
+static double sRunLocked(void)
+{
+    LockedQueue locked = {PTHREAD_MUTEX_INITIALIZER, Queue__new()};
+    int64_t checksum = 0;
+    int64_t value;
+    pthread_t thread;
+    struct timespec start;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&thread, NULL, sLockedProducer, &locked);
+
+    for (int64_t received = 0; received < MESSAGES;)
+    {
+        pthread_mutex_lock(&locked.mutex);
+
+        if (locked.queue->numberOfNodes > 0)
+        {
+            Queue__dequeueInto(locked.queue, &value, sizeof(int64_t), NULL);
+            checksum += value;
+            received++;
+            pthread_mutex_unlock(&locked.mutex);
+        }
+        else
+        {
+            pthread_mutex_unlock(&locked.mutex);
+            sched_yield();
+        }
+    }
+
+    pthread_join(thread, NULL);
+    double nanoseconds = sSince(&start);
+    sChecksum = checksum;
+    Queue__del(locked.queue);
+
+    return nanoseconds;
+}
+
+int main(void)
+{
+    printf("%20s %14s\n", "queue", "ns/message");
+    printf("%20s %14.1f\n", "SpscQueue", sRunSpsc(sSpscProducer, 1));
+    printf("%20s %14.1f\n", "SpscQueue batch 32", sRunSpsc(sSpscBatchProducer, BATCH));
+    printf("%20s %14.1f\n", "Queue + mutex", sRunLocked());
+
+    return 0;
+}
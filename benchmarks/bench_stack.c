@@ -0,0 +1,109 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cbarroso/lockfreestack.h>
+#include <cbarroso/stack.h>
+
+#define OPERATIONS 1000000
+
+/* Compares LockFreeStack against a Stack behind a mutex, each thread doing
+push/pop pairs on the shared stack as a recycling free list would */
+
+typedef struct LockedStack
+{
+    pthread_mutex_t mutex;
+    Stack *stack;
+} LockedStack;
+
+typedef struct Worker
+{
+    void *stack;
+    int operations;
+} Worker;
+
+static void *sLockFreeWorker(void *argument)
+{
+    Worker *worker = argument;
+
+    for (long value = 0; value < worker->operations; value++)
+    {
+        LockFreeStack__push(worker->stack, &value);
+        LockFreeStack__pop(worker->stack, &value);
+    }
+
+    return NULL;
+}
+
+static void *sLockedWorker(void *argument)
+{
+    Worker *worker = argument;
+    LockedStack *locked = worker->stack;
+
+    for (long value = 0; value < worker->operations; value++)
+    {
+        pthread_mutex_lock(&locked->mutex);
+        Stack__push(locked->stack, &value, sizeof(long));
+        pthread_mutex_unlock(&locked->mutex);
+
+        pthread_mutex_lock(&locked->mutex);
+        Stack__popInto(locked->stack, &value, sizeof(long), NULL);
+        pthread_mutex_unlock(&locked->mutex);
+    }
+
+    return NULL;
+}
+
+static double sRun(void *(*routine)(void *), void *stack, int numberOfThreads)
+{
+    pthread_t threads[64];
+    Worker worker = {stack, OPERATIONS / numberOfThreads};
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int t = 0; t < numberOfThreads; t++)
+    {
+        pthread_create(&threads[t], NULL, routine, &worker);
+    }
+
+    for (int t = 0; t < numberOfThreads; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    return seconds * 1e9 / (2.0 * worker.operations * numberOfThreads);
+}
+
+int main(int argc, char **argv)
+{
+    int maxThreads = argc > 1 ? atoi(argv[1]) : 8;
+
+    if (maxThreads < 1 || maxThreads > 64)
+    {
+        fprintf(stderr, "Usage: %s [threads (1-64)]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%8s %18s %18s\n", "threads", "lock-free ns/op", "mutex ns/op");
+
+    for (int numberOfThreads = 1; numberOfThreads <= maxThreads; numberOfThreads *= 2)
+    {
+        LockFreeStack *lockFree = LockFreeStack__new(sizeof(long), 1024);
+        LockedStack locked = {PTHREAD_MUTEX_INITIALIZER, Stack__newFixed(sizeof(long))};
+
+        double lockFreeTime = sRun(sLockFreeWorker, lockFree, numberOfThreads);
+        double lockedTime = sRun(sLockedWorker, &locked, numberOfThreads);
+
+        printf("%8d %18.1f %18.1f\n", numberOfThreads, lockFreeTime, lockedTime);
+
+        LockFreeStack__del(lockFree);
+        Stack__del(locked.stack);
+    }
+
+    return 0;
+}
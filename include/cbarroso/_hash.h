@@ -1,10 +1,12 @@
 #ifndef CBARROSO_HASH_H
 #define CBARROSO_HASH_H
 
+#include <stdint.h>
 #include <unistd.h>
 
 typedef unsigned long long int hash_t;
 
 hash_t hashBuffer(const void *buffer, size_t len);
+hash_t hashBufferWithKey(uint64_t k0, uint64_t k1, const void *buffer, size_t len);
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef CBARROSO_BLOCKINGQUEUE_H
+#define CBARROSO_BLOCKINGQUEUE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/ringqueue.h>
+
+/* Timeout of the wait calls that never gives up */
+#define BLOCKING_QUEUE_WAIT_FOREVER UINT64_MAX
+#define BLOCKING_QUEUE_MIN_SPINS 16
+#define BLOCKING_QUEUE_MAX_SPINS 4096
+
+/* Unbounded FIFO of fixed-size elements whose consumers can wait for
+elements. A waiting consumer first spins on `size` for an adaptive number
+of rounds and only then parks on the condition variable, which is futex
+based on Linux. Producers skip the wake-up call when nobody is parked */
+typedef struct BlockingQueue
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t notEmpty;
+    /* Guarded by `mutex` */
+    RingQueue *ring;
+    uint32_t waiters;
+    /* Mirror of the number of elements, read without the lock by spinners */
+    _Atomic size_t size;
+    /* Grows when spinning finds elements, shrinks when it does not */
+    _Atomic uint32_t spinLimit;
+} BlockingQueue;
+
+BlockingQueue *BlockingQueue__new(size_t elementSize);
+int8_t BlockingQueue__enqueue(BlockingQueue *self, const void *value);
+int8_t BlockingQueue__dequeueWait(BlockingQueue *self, void *buffer, uint64_t timeoutNanoseconds);
+int8_t BlockingQueue__dequeueBatch(BlockingQueue *self,
+                                   void *buffer,
+                                   size_t maxElements,
+                                   uint64_t timeoutNanoseconds,
+                                   size_t *countAddr);
+void BlockingQueue__del(BlockingQueue *self);
+
+#endif
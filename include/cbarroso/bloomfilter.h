@@ -0,0 +1,46 @@
+#ifndef CBARROSO_BLOOMFILTER_H
+#define CBARROSO_BLOOMFILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/_hash.h>
+
+/* Each key sets all of its bits inside one 512-bit block, a cache line, so
+a query touches a single line */
+#define BLOOM_FILTER_BLOCK_WORDS 8
+#define BLOOM_FILTER_BLOCK_BITS (BLOOM_FILTER_BLOCK_WORDS * 64)
+#define BLOOM_FILTER_MAX_HASHES 16
+
+typedef struct BloomFilterBlock
+{
+    uint64_t words[BLOOM_FILTER_BLOCK_WORDS];
+} BloomFilterBlock;
+
+typedef struct BloomFilter
+{
+    /* SipHash key used by the unhashed API and kept when serializing */
+    uint64_t k0;
+    uint64_t k1;
+    uint32_t numberOfBlocks;
+    uint8_t numberOfHashes;
+    BloomFilterBlock *blocks;
+} BloomFilter;
+
+BloomFilter *BloomFilter__new(size_t expectedItems,
+                              double falsePositiveRate,
+                              uint64_t k0,
+                              uint64_t k1);
+int8_t BloomFilter__add(BloomFilter *self, const void *key, size_t keySize);
+int8_t BloomFilter__addHashed(BloomFilter *self, hash_t hash);
+int8_t BloomFilter__addBatch(BloomFilter *self,
+                             void **keys,
+                             const size_t *keySizes,
+                             size_t count);
+uint8_t BloomFilter__mayContain(BloomFilter *self, const void *key, size_t keySize);
+uint8_t BloomFilter__mayContainHashed(BloomFilter *self, hash_t hash);
+size_t BloomFilter__serializedSize(BloomFilter *self);
+int8_t BloomFilter__serialize(BloomFilter *self, void *buffer, size_t capacity);
+BloomFilter *BloomFilter__deserialize(const void *buffer, size_t size);
+void BloomFilter__del(BloomFilter *self);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef CBARROSO_CHUNKEDQUEUE_H
+#define CBARROSO_CHUNKEDQUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CHUNKED_QUEUE_BLOCK_ELEMENTS 256
+#define CHUNKED_QUEUE_MAX_FREE_BLOCKS 4
+
+/* Block of CHUNKED_QUEUE_BLOCK_ELEMENTS inline elements */
+typedef struct ChunkedQueueBlock
+{
+    struct ChunkedQueueBlock *next;
+    _Alignas(max_align_t) char elements[];
+} ChunkedQueueBlock;
+
+/* Unbounded FIFO of fixed-size elements stored in a chain of blocks, so
+growing never copies and costs one allocation per block at most. Emptied
+blocks are kept on a short free list for reuse */
+typedef struct ChunkedQueue
+{
+    ChunkedQueueBlock *head;
+    ChunkedQueueBlock *tail;
+    /* Position of the first element in `head` */
+    size_t headIndex;
+    /* Position after the last element in `tail` */
+    size_t tailIndex;
+    size_t elementSize;
+    size_t numberOfElements;
+    ChunkedQueueBlock *freeBlocks;
+    size_t numberOfFreeBlocks;
+} ChunkedQueue;
+
+ChunkedQueue *ChunkedQueue__new(size_t elementSize);
+int8_t ChunkedQueue__enqueue(ChunkedQueue *self, const void *value);
+int8_t ChunkedQueue__dequeue(ChunkedQueue *self, void *buffer);
+int8_t ChunkedQueue__peek(ChunkedQueue *self, void **valueAddr);
+void ChunkedQueue__del(ChunkedQueue *self);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef CBARROSO_COUNTMIN_H
+#define CBARROSO_COUNTMIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/_hash.h>
+
+#define COUNT_MIN_MAX_DEPTH 16
+
+/* Estimates key frequencies, never below the true count and above it by at
+most epsilon times the total with probability 1 - delta */
+typedef struct CountMinSketch
+{
+    /* SipHash key, sketches can only be merged when it matches */
+    uint64_t k0;
+    uint64_t k1;
+    /* Counters per row, a power of two */
+    size_t width;
+    uint8_t depth;
+    uint64_t total;
+    /* `depth` rows of `width` counters */
+    uint64_t *counters;
+} CountMinSketch;
+
+CountMinSketch *CountMinSketch__new(double epsilon, double delta, uint64_t k0, uint64_t k1);
+int8_t CountMinSketch__add(CountMinSketch *self, const void *key, size_t keySize, uint64_t count);
+int8_t CountMinSketch__addHashed(CountMinSketch *self, hash_t hash, uint64_t count);
+uint64_t CountMinSketch__estimate(const CountMinSketch *self, const void *key, size_t keySize);
+uint64_t CountMinSketch__estimateHashed(const CountMinSketch *self, hash_t hash);
+int8_t CountMinSketch__merge(CountMinSketch *self, const CountMinSketch *other);
+void CountMinSketch__del(CountMinSketch *self);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef CBARROSO_EVENTQUEUE_H
+#define CBARROSO_EVENTQUEUE_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/ringqueue.h>
+
+/* Unbounded FIFO of fixed-size elements feeding an epoll loop, Linux only.
+`eventFd` becomes readable when the queue goes from empty to non-empty and
+stays so until a drain empties it, so any number of enqueues in between
+cost a single wake-up */
+typedef struct EventQueue
+{
+    pthread_mutex_t mutex;
+    /* Guarded by `mutex` */
+    RingQueue *ring;
+    /* Whether `eventFd` was signalled since the queue was last emptied */
+    uint8_t signalled;
+    /* Nonblocking eventfd to register for EPOLLIN */
+    int eventFd;
+} EventQueue;
+
+EventQueue *EventQueue__new(size_t elementSize);
+int8_t EventQueue__enqueue(EventQueue *self, const void *value);
+int8_t EventQueue__drain(EventQueue *self, void *buffer, size_t maxElements, size_t *countAddr);
+void EventQueue__del(EventQueue *self);
+
+#endif
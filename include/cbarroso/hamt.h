@@ -0,0 +1,83 @@
+#ifndef CBARROSO_HAMT_H
+#define CBARROSO_HAMT_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/_hash.h>
+
+/* Hash bits consumed per level, giving 32-way nodes */
+#define HAMT_BITS 5
+#define HAMT_WIDTH (1 << HAMT_BITS)
+
+#define HAMT_LEAF 0
+#define HAMT_BRANCH 1
+#define HAMT_COLLISION 2
+
+/* Header shared by every node. Nodes are immutable once built and shared
+between versions, which own them through `refcount` */
+typedef struct HamtNode
+{
+    atomic_size_t refcount;
+    uint8_t kind;
+} HamtNode;
+
+typedef struct HamtLeaf
+{
+    HamtNode header;
+    hash_t hash;
+    size_t keySize;
+    size_t valueSize;
+    /* The key followed by the value, which starts at an aligned offset */
+    char data[];
+} HamtLeaf;
+
+typedef struct HamtBranch
+{
+    HamtNode header;
+    /* One bit per present child, children being stored in bit order */
+    uint32_t bitmap;
+    HamtNode *children[];
+} HamtBranch;
+
+/* Leaves whose whole hash is equal */
+typedef struct HamtCollision
+{
+    HamtNode header;
+    hash_t hash;
+    uint32_t count;
+    HamtNode *children[];
+} HamtCollision;
+
+/* One immutable version of the map */
+typedef struct Hamt
+{
+    atomic_size_t refcount;
+    HamtNode *root;
+    size_t count;
+} Hamt;
+
+Hamt *Hamt__new(void);
+Hamt *Hamt__set(const Hamt *self,
+                void *key,
+                size_t keySize,
+                void *value,
+                size_t valueSize);
+Hamt *Hamt__setHashed(const Hamt *self,
+                      void *key,
+                      size_t keySize,
+                      hash_t hash,
+                      void *value,
+                      size_t valueSize);
+int8_t Hamt__get(const Hamt *self, void *key, size_t keySize, void **valueAddr);
+int8_t Hamt__getHashed(const Hamt *self,
+                       void *key,
+                       size_t keySize,
+                       hash_t hash,
+                       void **valueAddr);
+Hamt *Hamt__remove(const Hamt *self, void *key, size_t keySize);
+Hamt *Hamt__removeHashed(const Hamt *self, void *key, size_t keySize, hash_t hash);
+Hamt *Hamt__snapshot(Hamt *self);
+void Hamt__del(Hamt *self);
+
+#endif
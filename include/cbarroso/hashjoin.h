@@ -0,0 +1,54 @@
+#ifndef CBARROSO_HASHJOIN_H
+#define CBARROSO_HASHJOIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/hashmap.h>
+
+typedef struct HashJoinRow
+{
+    /* Identifier of the build-side row */
+    size_t rowId;
+    /* Position in `rows` of the previous row with the same key, or -1 */
+    ssize_t next;
+} HashJoinRow;
+
+typedef struct HashJoin
+{
+    /* Maps each distinct build key to the position of its latest row */
+    HashMap *heads;
+    /* Build-side rows, chained by key */
+    HashJoinRow *rows;
+    size_t numberOfRows;
+    size_t capacity;
+} HashJoin;
+
+typedef struct HashJoinMatch
+{
+    size_t buildRow;
+    /* Position of the matching key in the probed batch */
+    size_t probeRow;
+} HashJoinMatch;
+
+/* Where `HashJoin__probeBatch` resumes when the output buffer filled up */
+typedef struct HashJoinCursor
+{
+    /* Position of the next key to probe in the batch */
+    size_t position;
+    /* Next build row of the key being emitted, or -1 */
+    ssize_t chain;
+} HashJoinCursor;
+
+HashJoin *HashJoin__new(uint8_t log2_size);
+int8_t HashJoin__build(HashJoin *self, void *key, size_t keySize, size_t rowId);
+void HashJoinCursor__reset(HashJoinCursor *self);
+size_t HashJoin__probeBatch(HashJoin *self,
+                            void **keys,
+                            const size_t *keySizes,
+                            size_t count,
+                            HashJoinMatch *matches,
+                            size_t capacity,
+                            HashJoinCursor *cursor);
+void HashJoin__del(HashJoin *self);
+
+#endif
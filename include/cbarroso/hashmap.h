@@ -2,9 +2,26 @@
 #define CBARROSO_HASHMAP_H
 
 #include <cbarroso/_hash.h>
+#include <cbarroso/timingwheel.h>
 #include <stdint.h>
 
 #define LOG2_MINSIZE 3
+/* Lookups taking this many probes or more share the last histogram bucket */
+#define HASHMAP_PROBE_HISTOGRAM_SIZE 16
+
+typedef struct HashMapDigest
+{
+    /* SipHash key shared by the replicas being compared */
+    uint64_t k0, k1;
+    /* $\log_2{number_of_buckets}$ */
+    uint8_t log2_buckets;
+    /* Sum of the hashes of every (key, value) pair */
+    uint64_t total;
+    /* Head of the list of entries in each bucket */
+    struct HashMapEntry **bucketEntries;
+    /* Same sum restricted to each range of key hashes */
+    uint64_t buckets[];
+} HashMapDigest;
 
 typedef struct HashMap
 {
@@ -16,11 +33,28 @@ typedef struct HashMap
     ssize_t usable;
     /* Number of used slots */
     ssize_t nentries;
+    /* Number of keys in the map, which excludes the removed entries */
+    ssize_t nitems;
+    /* Sequence number given to the next inserted entry */
+    size_t nextSequence;
+    /* Content digest, `NULL` unless enabled */
+    HashMapDigest *digest;
+    /* Current time, in caller-defined ticks, against which TTLs are checked */
+    uint64_t clock;
+    /* Expiry schedule of the keys with a TTL, `NULL` until one is set */
+    TimingWheel *wheel;
+    /* Number of times the map grew, which lets iterators notice a resize */
+    size_t resizes;
+#ifdef CBR_HASHMAP_COUNTERS
+    /* Number of index slots visited by lookups */
+    size_t probes;
+#endif
     /* An array of `uint{2^log2_index_bytes}_t` indices for the `entries` array*/
-    char indices[];
-    /* When allocating memory for `HashMap`, an extra space of
-    `(1 << log2_index_bytes)` is allocated for the
-    `indices` and `(sizeof(HashMapEntry) * usable)` for the `entries` array*/
+    char *indices;
+    /* The `indices` buffer is allocated separately from the `HashMap` so it
+    can be replaced on resize without moving the map itself. An extra space of
+    `(sizeof(HashMapEntry *) * usable)` is allocated after the
+    `(1 << log2_index_bytes)` bytes of indices for the `entries` array */
     /* The hidden `entries` array is where the values actually reside */
 } HashMap;
 
@@ -30,11 +64,68 @@ typedef struct HashMapEntry
     void *key;
     /* The size of the key buffer in bytes */
     size_t keySize;
+    /* Points to `inlineValue` for values of up to 8 bytes, which saves a
+    separate allocation for counters */
     void *value;
     /* The size of the value buffer in bytes */
     size_t valueSize;
+    uint64_t inlineValue;
+    /* Insertion order of the entry, kept across resizes */
+    size_t sequence;
+    /* Expiry timer, `NULL` for keys without a TTL */
+    TimingWheelTimer *timer;
+    /* Key hash under the digest key, and links in the list of its digest
+    bucket, unused without a digest */
+    hash_t digestKeyHash;
+    struct HashMapEntry *digestPrev;
+    struct HashMapEntry *digestNext;
 } HashMapEntry;
 
+/* Combines `delta` into `value` in place, both being `valueSize` bytes long */
+typedef void (*HashMapMergeFunction)(void *value,
+                                     const void *delta,
+                                     size_t valueSize,
+                                     void *context);
+
+typedef struct HashMapIterator
+{
+    HashMap *map;
+    /* Map resize count the position refers to, used to detect resizes */
+    size_t resizes;
+    /* Position of the next entry to visit in the `entries` array */
+    ssize_t position;
+    /* Sequence number of the next entry to visit */
+    size_t sequence;
+} HashMapIterator;
+
+typedef struct HashMapStats
+{
+    /* Number of slots in the index */
+    size_t size;
+    /* Used slots of the `entries` array over `size` */
+    double loadFactor;
+    /* Number of entries holding a key whose TTL has not run out */
+    size_t nitems;
+    /* Index slots left behind by removed keys */
+    size_t deadSlots;
+    /* Width of each index in bytes: 1, 2, 4 or 8 */
+    uint8_t indexBytes;
+    /* Bytes used by the `indices` array */
+    size_t indicesBytes;
+    /* Bytes used by the `entries` array and the entries it points to */
+    size_t entriesBytes;
+    /* Bytes used by the keys and values */
+    size_t payloadBytes;
+    /* Number of entries sampled to build `probeHistogram` */
+    size_t sampledEntries;
+    /* `probeHistogram[i]` counts sampled keys found after `i + 1` probes */
+    size_t probeHistogram[HASHMAP_PROBE_HISTOGRAM_SIZE];
+#ifdef CBR_HASHMAP_COUNTERS
+    size_t resizes;
+    size_t probes;
+#endif
+} HashMapStats;
+
 HashMap *HashMap__new(uint8_t log2_size);
 HashMapEntry **HashMap__getEntries(HashMap *self);
 int8_t HashMap__setItem(HashMap *self,
@@ -42,10 +133,75 @@ int8_t HashMap__setItem(HashMap *self,
                         size_t keySize,
                         void *value,
                         size_t valueSize);
+int8_t HashMap__setItemTTL(HashMap *self,
+                           void *key,
+                           size_t keySize,
+                           void *value,
+                           size_t valueSize,
+                           uint64_t ttl);
+size_t HashMap__advanceClock(HashMap *self, uint64_t now, size_t maxExpired);
+int8_t HashMap__reserveItem(HashMap *self,
+                            void *key,
+                            size_t keySize,
+                            size_t valueSize,
+                            HashMapEntry **entryAddr);
 int8_t HashMap__getItem(HashMap *self,
                         void *key,
                         size_t keySize,
                         void **valueAddr);
+int8_t HashMap__getItemHashed(HashMap *self,
+                              void *key,
+                              size_t keySize,
+                              hash_t hash,
+                              void **valueAddr);
+void HashMap__prefetch(HashMap *self, hash_t hash);
+int8_t HashMap__delItem(HashMap *self, void *key, size_t keySize);
+int8_t HashMap__mergeWith(HashMap *self,
+                          void *key,
+                          size_t keySize,
+                          void *delta,
+                          size_t valueSize,
+                          HashMapMergeFunction merge,
+                          void *context,
+                          void **valueAddr);
+int8_t HashMap__addInt64(HashMap *self,
+                         void *key,
+                         size_t keySize,
+                         int64_t delta,
+                         int64_t *resultAddr);
+int8_t HashMap__addDouble(HashMap *self,
+                          void *key,
+                          size_t keySize,
+                          double delta,
+                          double *resultAddr);
+int8_t HashMap__addInt64Batch(HashMap *self,
+                              void **keys,
+                              const size_t *keySizes,
+                              const int64_t *deltas,
+                              size_t count);
+int8_t HashMap__addDoubleBatch(HashMap *self,
+                               void **keys,
+                               const size_t *keySizes,
+                               const double *deltas,
+                               size_t count);
+void HashMap__iter(HashMap *self, HashMapIterator *iterator);
+int8_t HashMapIterator__next(HashMapIterator *self, HashMapEntry **entryAddr);
+size_t HashMap__scan(HashMap *self,
+                     size_t cursor,
+                     HashMapEntry **entries,
+                     size_t capacity,
+                     size_t *countAddr);
+int8_t HashMap__enableDigest(HashMap *self,
+                             uint64_t k0,
+                             uint64_t k1,
+                             uint8_t log2_buckets);
+uint64_t HashMap__getDigest(HashMap *self);
+const uint64_t *HashMap__getDigestBuckets(HashMap *self, size_t *nbucketsAddr);
+size_t HashMap__getDigestBucketEntries(HashMap *self,
+                                       size_t bucket,
+                                       HashMapEntry **entries,
+                                       size_t capacity);
+int8_t HashMap__stats(HashMap *self, HashMapStats *stats, size_t sampleStride);
 void HashMap__del(HashMap * self);
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef CBARROSO_HASHRING_H
+#define CBARROSO_HASHRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/_hash.h>
+
+/* Virtual node of a backend node on the ring */
+typedef struct HashRingPoint
+{
+    hash_t hash;
+    uint32_t nodeId;
+} HashRingPoint;
+
+typedef struct HashRing
+{
+    /* SipHash key, rings agree on placement when it matches */
+    uint64_t k0;
+    uint64_t k1;
+    /* Virtual nodes per unit of weight */
+    uint32_t virtualNodes;
+    /* Sorted by hash */
+    HashRingPoint *points;
+    size_t numberOfPoints;
+    size_t capacity;
+} HashRing;
+
+HashRing *HashRing__new(uint32_t virtualNodes, uint64_t k0, uint64_t k1);
+int8_t HashRing__addNode(HashRing *self, uint32_t nodeId, uint32_t weight);
+int8_t HashRing__removeNode(HashRing *self, uint32_t nodeId);
+int8_t HashRing__getNode(HashRing *self, const void *key, size_t keySize, uint32_t *nodeAddr);
+int8_t HashRing__getNodeHashed(HashRing *self, hash_t hash, uint32_t *nodeAddr);
+int8_t HashRing__getNodeBatch(HashRing *self,
+                              void **keys,
+                              const size_t *keySizes,
+                              size_t count,
+                              uint32_t *nodes);
+void HashRing__del(HashRing *self);
+
+int32_t jumpConsistentHash(uint64_t key, int32_t numberOfBuckets);
+
+#endif
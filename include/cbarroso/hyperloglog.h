@@ -0,0 +1,30 @@
+#ifndef CBARROSO_HYPERLOGLOG_H
+#define CBARROSO_HYPERLOGLOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/_hash.h>
+
+#define HYPERLOGLOG_MIN_PRECISION 4
+#define HYPERLOGLOG_MAX_PRECISION 18
+
+/* Estimates the number of distinct keys in 2^precision bytes, with a
+standard error of about 1.04 / sqrt(2^precision) */
+typedef struct HyperLogLog
+{
+    /* SipHash key, sketches can only be merged when it matches */
+    uint64_t k0;
+    uint64_t k1;
+    uint8_t precision;
+    /* Largest rank seen per register, 2^precision of them */
+    uint8_t *registers;
+} HyperLogLog;
+
+HyperLogLog *HyperLogLog__new(uint8_t precision, uint64_t k0, uint64_t k1);
+int8_t HyperLogLog__add(HyperLogLog *self, const void *key, size_t keySize);
+int8_t HyperLogLog__addHashed(HyperLogLog *self, hash_t hash);
+int8_t HyperLogLog__merge(HyperLogLog *self, const HyperLogLog *other);
+double HyperLogLog__estimate(const HyperLogLog *self);
+void HyperLogLog__del(HyperLogLog *self);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef CBARROSO_LOCKFREESTACK_H
+#define CBARROSO_LOCKFREESTACK_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LOCK_FREE_STACK_ELIMINATION_SLOTS 8
+#define LOCK_FREE_STACK_ELIMINATION_SPINS 64
+
+/* Treiber stack of fixed-size elements, safe for any number of threads.
+Elements are copied into nodes of a pool allocated up front. Lists are
+headed by a 32-bit node index, 0 meaning empty, packed with a 32-bit tag
+bumped on every change so a stale compare-and-swap fails instead of
+suffering ABA */
+typedef struct LockFreeStack
+{
+    _Atomic uint64_t top;
+    /* Nodes not holding an element */
+    _Atomic uint64_t free;
+    /* Push offers waiting for a pop, tagged with a ticket, 0 when empty */
+    _Atomic uint64_t elimination[LOCK_FREE_STACK_ELIMINATION_SLOTS];
+    _Atomic uint32_t tickets;
+    /* Next node index per node */
+    _Atomic uint32_t *next;
+    char *values;
+    size_t elementSize;
+    uint32_t capacity;
+} LockFreeStack;
+
+LockFreeStack *LockFreeStack__new(size_t elementSize, uint32_t capacity);
+int8_t LockFreeStack__push(LockFreeStack *self, const void *value);
+int8_t LockFreeStack__pop(LockFreeStack *self, void *buffer);
+void LockFreeStack__del(LockFreeStack *self);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef CBARROSO_LRUCACHE_H
+#define CBARROSO_LRUCACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/hashmap.h>
+
+/* Keeps an exact recency list, updated on every hit */
+#define LRU_CACHE_MODE_EXACT 0
+/* Skips list maintenance and evicts the oldest of a few sampled entries */
+#define LRU_CACHE_MODE_SAMPLED 1
+/* Number of entries compared by each sampled eviction */
+#define LRU_CACHE_SAMPLES 5
+
+/* Stored in place as the value of the index entry, so each item is a single
+hash map entry with no allocation of its own */
+typedef struct LruCacheNode
+{
+    /* Recency list links, the most recently used node being the head */
+    struct LruCacheNode *prev;
+    struct LruCacheNode *next;
+    /* Position in the `nodes` array of the sampled mode */
+    size_t position;
+    /* Value of the cache clock when the node was last used */
+    uint64_t lastAccess;
+    /* Index entry holding the node, and the key */
+    HashMapEntry *entry;
+    _Alignas(16) char value[];
+} LruCacheNode;
+
+typedef void (*LruCacheEvictFunction)(void *key,
+                                      size_t keySize,
+                                      void *value,
+                                      size_t valueSize,
+                                      void *context);
+
+typedef struct LruCache
+{
+    /* Maps each key to its `LruCacheNode` followed by the value */
+    HashMap *index;
+    LruCacheNode *head;
+    LruCacheNode *tail;
+    /* Every node, for the sampled mode to pick from */
+    LruCacheNode **nodes;
+    size_t numberOfNodes;
+    size_t nodesCapacity;
+    /* Budget and usage in bytes, counting `keySize + valueSize` per item */
+    size_t maxBytes;
+    size_t usedBytes;
+    uint8_t mode;
+    uint64_t clock;
+    uint64_t randomState;
+    LruCacheEvictFunction onEvict;
+    void *evictContext;
+} LruCache;
+
+LruCache *LruCache__new(size_t maxBytes,
+                        uint8_t mode,
+                        LruCacheEvictFunction onEvict,
+                        void *evictContext);
+int8_t LruCache__put(LruCache *self,
+                     void *key,
+                     size_t keySize,
+                     void *value,
+                     size_t valueSize);
+int8_t LruCache__get(LruCache *self,
+                     void *key,
+                     size_t keySize,
+                     void **valueAddr);
+int8_t LruCache__remove(LruCache *self, void *key, size_t keySize);
+void LruCache__del(LruCache *self);
+
+#endif
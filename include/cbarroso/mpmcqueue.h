@@ -0,0 +1,35 @@
+#ifndef CBARROSO_MPMCQUEUE_H
+#define CBARROSO_MPMCQUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MPMC_QUEUE_CACHE_LINE 64
+/* Busy-wait rounds of the blocking calls before yielding the CPU */
+#define MPMC_QUEUE_SPINS 128
+
+/* Bounded FIFO of fixed-size elements for any number of producer and
+consumer threads, after Dmitry Vyukov's design. Each cell carries a
+sequence number telling whether it is ready for the producer or the
+consumer of a given position, so producers only contend on the enqueue
+position and consumers on the dequeue position */
+typedef struct MpmcQueue
+{
+    _Alignas(MPMC_QUEUE_CACHE_LINE) _Atomic size_t enqueuePosition;
+    _Alignas(MPMC_QUEUE_CACHE_LINE) _Atomic size_t dequeuePosition;
+    /* Read-only once created */
+    _Alignas(MPMC_QUEUE_CACHE_LINE) char *cells;
+    size_t cellSize;
+    size_t elementSize;
+    size_t capacity;
+} MpmcQueue;
+
+MpmcQueue *MpmcQueue__new(size_t elementSize, size_t capacity);
+int8_t MpmcQueue__tryEnqueue(MpmcQueue *self, const void *value);
+int8_t MpmcQueue__tryDequeue(MpmcQueue *self, void *buffer);
+int8_t MpmcQueue__enqueue(MpmcQueue *self, const void *value);
+int8_t MpmcQueue__dequeue(MpmcQueue *self, void *buffer);
+void MpmcQueue__del(MpmcQueue *self);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef CBARROSO_MPSCQUEUE_H
+#define CBARROSO_MPSCQUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MPSC_QUEUE_CACHE_LINE 64
+
+/* Same layout as `SinglyLinkedListNode`, with an atomic `next`. Nodes are
+owned by the caller, usually embedded in the message, and the queue never
+allocates nor frees them */
+typedef struct MpscQueueNode
+{
+    void *value;
+    size_t valueSize;
+    _Atomic(struct MpscQueueNode *) next;
+} MpscQueueNode;
+
+/* Unbounded FIFO for any number of producer threads and one consumer
+thread, after Dmitry Vyukov's intrusive queue. Nodes are linked from the
+oldest, `tail`, to the newest, `head` */
+typedef struct MpscQueue
+{
+    /* Swapped by producers */
+    _Alignas(MPSC_QUEUE_CACHE_LINE) _Atomic(MpscQueueNode *) head;
+    /* Owned by the consumer */
+    _Alignas(MPSC_QUEUE_CACHE_LINE) MpscQueueNode *tail;
+    /* Placeholder keeping the chain non-empty */
+    MpscQueueNode stub;
+} MpscQueue;
+
+MpscQueue *MpscQueue__new(void);
+void MpscQueueNode__init(MpscQueueNode *self, void *value, size_t valueSize);
+int8_t MpscQueue__enqueue(MpscQueue *self, MpscQueueNode *node);
+MpscQueueNode *MpscQueue__dequeue(MpscQueue *self);
+MpscQueueNode *MpscQueue__drain(MpscQueue *self, size_t *countAddr);
+void MpscQueue__del(MpscQueue *self);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef CBARROSO_PRIORITYQUEUE_H
+#define CBARROSO_PRIORITYQUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PRIORITY_QUEUE_DEFAULT_ARITY 4
+#define INDEXED_PRIORITY_QUEUE_ABSENT UINT32_MAX
+
+/* Returns a negative number when `left` should come out before `right`, zero
+when they tie and a positive number otherwise */
+typedef int (*PriorityQueueCompareFunction)(const void *left, const void *right, void *context);
+
+/* Implicit d-ary heap of fixed-size elements stored inline. A wider node
+halves the depth of a binary heap at d = 4 and keeps the children of a node
+on the same cache line or two */
+typedef struct PriorityQueue
+{
+    char *buffer;
+    size_t elementSize;
+    size_t capacity;
+    size_t numberOfElements;
+    size_t arity;
+    PriorityQueueCompareFunction compare;
+    void *context;
+    /* Holds the element being sifted */
+    char *scratch;
+} PriorityQueue;
+
+/* Heap over the IDs 0 to `maxIds` - 1, each with a value stored inline by ID,
+so the priority of a queued ID can be changed in O(log n) */
+typedef struct IndexedPriorityQueue
+{
+    char *values;
+    size_t elementSize;
+    /* IDs in heap order */
+    uint32_t *heap;
+    /* Heap position of each ID, or INDEXED_PRIORITY_QUEUE_ABSENT */
+    uint32_t *positions;
+    uint32_t maxIds;
+    size_t numberOfElements;
+    size_t arity;
+    PriorityQueueCompareFunction compare;
+    void *context;
+} IndexedPriorityQueue;
+
+PriorityQueue *PriorityQueue__new(size_t elementSize,
+                                  size_t arity,
+                                  PriorityQueueCompareFunction compare,
+                                  void *context);
+PriorityQueue *PriorityQueue__fromArray(size_t elementSize,
+                                        size_t arity,
+                                        PriorityQueueCompareFunction compare,
+                                        void *context,
+                                        const void *elements,
+                                        size_t numberOfElements);
+int8_t PriorityQueue__push(PriorityQueue *self, const void *value);
+int8_t PriorityQueue__pop(PriorityQueue *self, void *buffer);
+int8_t PriorityQueue__peek(PriorityQueue *self, void **valueAddr);
+void PriorityQueue__del(PriorityQueue *self);
+
+IndexedPriorityQueue *IndexedPriorityQueue__new(size_t elementSize,
+                                                size_t arity,
+                                                uint32_t maxIds,
+                                                PriorityQueueCompareFunction compare,
+                                                void *context);
+int8_t IndexedPriorityQueue__push(IndexedPriorityQueue *self, uint32_t id, const void *value);
+int8_t IndexedPriorityQueue__decreaseKey(IndexedPriorityQueue *self, uint32_t id, const void *value);
+int8_t IndexedPriorityQueue__pop(IndexedPriorityQueue *self, uint32_t *idAddr, void *buffer);
+uint8_t IndexedPriorityQueue__contains(IndexedPriorityQueue *self, uint32_t id);
+void IndexedPriorityQueue__del(IndexedPriorityQueue *self);
+
+#endif
@@ -21,6 +21,8 @@ typedef struct Queue
 Queue *Queue__new();
 int8_t Queue__enqueue(Queue *self, void *value, size_t valueSize);
 int8_t Queue__dequeue(Queue *self, void **valueAddress);
+int8_t Queue__dequeueInto(Queue *self, void *buffer, size_t capacity, size_t *sizeAddr);
+int8_t Queue__peek(Queue *self, void **valueAddr, size_t *sizeAddr);
 void Queue__del(Queue *self);
 
 #endif
@@ -0,0 +1,25 @@
+#ifndef CBARROSO_RINGQUEUE_H
+#define CBARROSO_RINGQUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* FIFO of fixed-size elements stored inline in a power-of-two ring, which
+doubles when full */
+typedef struct RingQueue
+{
+    char *buffer;
+    size_t elementSize;
+    /* Always a power of two, positions being masked with capacity - 1 */
+    size_t capacity;
+    size_t head;
+    size_t numberOfElements;
+} RingQueue;
+
+RingQueue *RingQueue__new(size_t elementSize, size_t capacity);
+int8_t RingQueue__enqueue(RingQueue *self, const void *value);
+int8_t RingQueue__dequeue(RingQueue *self, void *buffer);
+int8_t RingQueue__peek(RingQueue *self, void **valueAddr);
+void RingQueue__del(RingQueue *self);
+
+#endif
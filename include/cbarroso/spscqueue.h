@@ -0,0 +1,35 @@
+#ifndef CBARROSO_SPSCQUEUE_H
+#define CBARROSO_SPSCQUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SPSC_QUEUE_CACHE_LINE 64
+
+/* Bounded FIFO of fixed-size elements between exactly one producer thread
+and one consumer thread. Each side owns a cache line holding its index and
+its last copy of the other side's index, so the shared line is only read
+when the cached copy says the queue looks full or empty */
+typedef struct SpscQueue
+{
+    /* Written by the producer */
+    _Alignas(SPSC_QUEUE_CACHE_LINE) _Atomic size_t tail;
+    size_t cachedHead;
+    /* Written by the consumer */
+    _Alignas(SPSC_QUEUE_CACHE_LINE) _Atomic size_t head;
+    size_t cachedTail;
+    /* Read-only once created */
+    _Alignas(SPSC_QUEUE_CACHE_LINE) char *buffer;
+    size_t elementSize;
+    size_t capacity;
+} SpscQueue;
+
+SpscQueue *SpscQueue__new(size_t elementSize, size_t capacity);
+int8_t SpscQueue__enqueue(SpscQueue *self, const void *value);
+int8_t SpscQueue__dequeue(SpscQueue *self, void *buffer);
+size_t SpscQueue__enqueueBatch(SpscQueue *self, const void *values, size_t count);
+size_t SpscQueue__dequeueBatch(SpscQueue *self, void *buffer, size_t count);
+void SpscQueue__del(SpscQueue *self);
+
+#endif
@@ -4,22 +4,36 @@
 #include <stddef.h>
 #include <stdint.h>
 
-typedef struct StackNode
-{
-    void *value;
-    size_t valueSize;
-    struct StackNode *next;
-} StackNode;
-
+/* Elements live contiguously in `buffer`, which grows geometrically. A
+fixed-size stack packs them back to back, otherwise each one is padded to
+`sizeof(size_t)` and followed by its size */
 typedef struct Stack
 {
-    StackNode *top;
+    /* Value of the top element inside `buffer`, NULL when empty */
+    void *top;
     size_t stackSize;
+    /* Size of every element, 0 when elements carry their own size */
+    size_t elementSize;
+    char *buffer;
+    size_t used;
+    size_t capacity;
 } Stack;
 
+/* Position of the stack returned by `Stack__mark` */
+typedef struct StackMark
+{
+    size_t used;
+    size_t stackSize;
+} StackMark;
+
 Stack *Stack__new();
+Stack *Stack__newFixed(size_t elementSize);
 int8_t Stack__push(Stack *self, void *value, size_t valueSize);
 int8_t Stack__pop(Stack *self, void **valueAddress);
+int8_t Stack__popInto(Stack *self, void *buffer, size_t capacity, size_t *sizeAddr);
+int8_t Stack__peek(Stack *self, void **valueAddr, size_t *sizeAddr);
+StackMark Stack__mark(Stack *self);
+int8_t Stack__rollback(Stack *self, StackMark mark);
 Stack *Stack__del(Stack *self);
 
 #endif
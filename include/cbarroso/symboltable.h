@@ -0,0 +1,48 @@
+#ifndef CBARROSO_SYMBOLTABLE_H
+#define CBARROSO_SYMBOLTABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cbarroso/_hash.h>
+
+/* Stored in `idAddr` by `SymbolTable__find` when the string is not interned */
+#define SYMBOL_TABLE_NO_ID UINT32_MAX
+/* Smallest arena block, larger strings get a block of their own */
+#define SYMBOL_TABLE_BLOCK_SIZE 4096
+
+/* Arena blocks are never moved nor freed before the table, so the bytes of
+a symbol keep their address for the table's lifetime */
+typedef struct SymbolTableBlock
+{
+    struct SymbolTableBlock *next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} SymbolTableBlock;
+
+typedef struct SymbolTableSymbol
+{
+    const char *data;
+    size_t size;
+    hash_t hash;
+} SymbolTableSymbol;
+
+typedef struct SymbolTable
+{
+    SymbolTableBlock *blocks;
+    /* Indexed by ID */
+    SymbolTableSymbol *symbols;
+    uint32_t numberOfSymbols;
+    uint32_t symbolsCapacity;
+    /* Open addressing index holding ID + 1, 0 marking an empty slot */
+    uint32_t *slots;
+    uint8_t log2_slots;
+} SymbolTable;
+
+SymbolTable *SymbolTable__new(void);
+int8_t SymbolTable__intern(SymbolTable *self, const void *key, size_t keySize, uint32_t *idAddr);
+int8_t SymbolTable__find(SymbolTable *self, const void *key, size_t keySize, uint32_t *idAddr);
+const char *SymbolTable__lookup(SymbolTable *self, uint32_t id, size_t *sizeAddr);
+void SymbolTable__del(SymbolTable *self);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef CBARROSO_TIMINGWHEEL_H
+#define CBARROSO_TIMINGWHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* $\log_2{slots_per_level}$ */
+#define TIMING_WHEEL_SLOT_BITS 6
+#define TIMING_WHEEL_SLOTS (1 << TIMING_WHEEL_SLOT_BITS)
+/* Six levels of 64 slots cover 2^36 ticks, farther deadlines are parked in
+the top level and placed again each time it turns */
+#define TIMING_WHEEL_LEVELS 6
+
+typedef struct TimingWheelTimer
+{
+    /* Tick at which the timer expires */
+    uint64_t deadline;
+    struct TimingWheelTimer *prev;
+    struct TimingWheelTimer *next;
+    /* Level holding the timer, or -1 when it is not scheduled */
+    int8_t level;
+    uint8_t slot;
+    /* Caller data handed back on expiry */
+    void *context;
+} TimingWheelTimer;
+
+typedef void (*TimingWheelExpireFunction)(TimingWheelTimer *timer, void *context);
+
+typedef struct TimingWheel
+{
+    /* Current tick */
+    uint64_t now;
+    size_t numberOfTimers;
+    /* One bit per non-empty slot of each level */
+    uint64_t occupied[TIMING_WHEEL_LEVELS];
+    TimingWheelTimer *slots[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SLOTS];
+    /* Timers already due that an advance left over once its budget ran out */
+    TimingWheelTimer *due;
+} TimingWheel;
+
+TimingWheel *TimingWheel__new(uint64_t now);
+void TimingWheelTimer__init(TimingWheelTimer *self, void *context);
+void TimingWheel__schedule(TimingWheel *self, TimingWheelTimer *timer, uint64_t deadline);
+void TimingWheel__cancel(TimingWheel *self, TimingWheelTimer *timer);
+size_t TimingWheel__advance(TimingWheel *self,
+                            uint64_t now,
+                            size_t maxExpired,
+                            TimingWheelExpireFunction onExpire,
+                            void *context);
+void TimingWheel__del(TimingWheel *self);
+
+#endif
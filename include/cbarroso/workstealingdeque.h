@@ -0,0 +1,38 @@
+#ifndef CBARROSO_WORKSTEALINGDEQUE_H
+#define CBARROSO_WORKSTEALINGDEQUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define WORK_STEALING_DEQUE_CACHE_LINE 64
+
+/* Circular array of items. Replaced arrays are kept until the deque is
+deleted, as a thief may still be reading one */
+typedef struct WorkStealingBuffer
+{
+    /* Always a power of two */
+    size_t capacity;
+    struct WorkStealingBuffer *previous;
+    _Atomic(void *) items[];
+} WorkStealingBuffer;
+
+/* Chase-Lev deque of pointers, typically tasks. The owner thread pushes and
+pops at the bottom, other threads steal from the top. Only a pop racing for
+the last item and steals need a compare-and-swap */
+typedef struct WorkStealingDeque
+{
+    /* Advanced by thieves and by the owner taking the last item */
+    _Alignas(WORK_STEALING_DEQUE_CACHE_LINE) _Atomic int64_t top;
+    /* Written by the owner only */
+    _Alignas(WORK_STEALING_DEQUE_CACHE_LINE) _Atomic int64_t bottom;
+    _Atomic(WorkStealingBuffer *) buffer;
+} WorkStealingDeque;
+
+WorkStealingDeque *WorkStealingDeque__new(size_t capacity);
+int8_t WorkStealingDeque__push(WorkStealingDeque *self, void *item);
+int8_t WorkStealingDeque__pop(WorkStealingDeque *self, void **itemAddr);
+int8_t WorkStealingDeque__steal(WorkStealingDeque *self, void **itemAddr);
+void WorkStealingDeque__del(WorkStealingDeque *self);
+
+#endif
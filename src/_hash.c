@@ -155,3 +155,10 @@ hash_t hashBuffer(const void *buffer, size_t len)
         le64toh(sipHashSecret->k0), le64toh(sipHashSecret->k1),
         buffer, len);
 }
+
+/* SipHash-1-3 under a caller-provided key, for hashes that must agree across
+processes, unlike `hashBuffer` whose secret is random per process */
+hash_t hashBufferWithKey(uint64_t k0, uint64_t k1, const void *buffer, size_t len)
+{
+    return sSiphash13(k0, k1, buffer, len);
+}
@@ -0,0 +1,205 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/blockingqueue.h>
+#include <cbarroso/ringqueue.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#else
+#define CPU_RELAX() ((void)0)
+#endif
+
+#define NANOSECONDS_PER_SECOND 1000000000ULL
+
+/* Spins until the queue looks non-empty or the spin budget runs out, then
+doubles or halves the budget depending on whether spinning paid off */
+static void sBlockingQueue__spin(BlockingQueue *self)
+{
+    uint32_t limit = atomic_load_explicit(&self->spinLimit, memory_order_relaxed);
+    uint32_t spins = 0;
+
+    while (spins < limit && atomic_load_explicit(&self->size, memory_order_relaxed) == 0)
+    {
+        CPU_RELAX();
+        spins++;
+    }
+
+    if (spins < limit)
+    {
+        limit = limit * 2 > BLOCKING_QUEUE_MAX_SPINS ? BLOCKING_QUEUE_MAX_SPINS : limit * 2;
+    }
+    else
+    {
+        limit = limit / 2 < BLOCKING_QUEUE_MIN_SPINS ? BLOCKING_QUEUE_MIN_SPINS : limit / 2;
+    }
+
+    atomic_store_explicit(&self->spinLimit, limit, memory_order_relaxed);
+}
+
+/* Returns with the mutex held and at least one element queued, or with the
+mutex released and CBR_ERROR once the timeout expires */
+static int8_t sBlockingQueue__waitNonEmpty(BlockingQueue *self, uint64_t timeoutNanoseconds)
+{
+    struct timespec deadline;
+
+    if (timeoutNanoseconds != 0)
+    {
+        sBlockingQueue__spin(self);
+    }
+
+    if (timeoutNanoseconds != BLOCKING_QUEUE_WAIT_FOREVER)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        uint64_t nanoseconds = (uint64_t)deadline.tv_nsec + timeoutNanoseconds % NANOSECONDS_PER_SECOND;
+        deadline.tv_sec += (time_t)(timeoutNanoseconds / NANOSECONDS_PER_SECOND + nanoseconds / NANOSECONDS_PER_SECOND);
+        deadline.tv_nsec = (long)(nanoseconds % NANOSECONDS_PER_SECOND);
+    }
+
+    pthread_mutex_lock(&self->mutex);
+
+    while (self->ring->numberOfElements == 0)
+    {
+        int result;
+
+        self->waiters++;
+
+        if (timeoutNanoseconds == BLOCKING_QUEUE_WAIT_FOREVER)
+        {
+            result = pthread_cond_wait(&self->notEmpty, &self->mutex);
+        }
+        else
+        {
+            result = pthread_cond_timedwait(&self->notEmpty, &self->mutex, &deadline);
+        }
+
+        self->waiters--;
+
+        if (result == ETIMEDOUT && self->ring->numberOfElements == 0)
+        {
+            pthread_mutex_unlock(&self->mutex);
+            return CBR_ERROR;
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+BlockingQueue *BlockingQueue__new(size_t elementSize)
+{
+    BlockingQueue *queue = malloc(sizeof(BlockingQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the blocking queue\n");
+        return NULL;
+    }
+
+    queue->ring = RingQueue__new(elementSize, 0);
+
+    if (queue->ring == NULL)
+    {
+        free(queue);
+        return NULL;
+    }
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    // Timeouts must not jump with the wall clock
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&queue->notEmpty, &attributes);
+    pthread_condattr_destroy(&attributes);
+    pthread_mutex_init(&queue->mutex, NULL);
+
+    queue->waiters = 0;
+    atomic_init(&queue->size, 0);
+    atomic_init(&queue->spinLimit, BLOCKING_QUEUE_MIN_SPINS);
+
+    return queue;
+}
+
+/* Copies `value` into the queue and wakes one parked consumer, if any */
+int8_t BlockingQueue__enqueue(BlockingQueue *self, const void *value)
+{
+    pthread_mutex_lock(&self->mutex);
+
+    if (RingQueue__enqueue(self->ring, value) == CBR_ERROR)
+    {
+        pthread_mutex_unlock(&self->mutex);
+        return CBR_ERROR;
+    }
+
+    atomic_store_explicit(&self->size, self->ring->numberOfElements, memory_order_relaxed);
+    uint32_t waiters = self->waiters;
+    pthread_mutex_unlock(&self->mutex);
+
+    if (waiters > 0)
+    {
+        pthread_cond_signal(&self->notEmpty);
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Dequeues the head element into `buffer`, waiting up to
+`timeoutNanoseconds` for one. A timeout of 0 only checks, and
+`BLOCKING_QUEUE_WAIT_FOREVER` never times out. Returns CBR_ERROR, without
+printing, on timeout */
+int8_t BlockingQueue__dequeueWait(BlockingQueue *self, void *buffer, uint64_t timeoutNanoseconds)
+{
+    size_t count;
+
+    return BlockingQueue__dequeueBatch(self, buffer, 1, timeoutNanoseconds, &count);
+}
+
+/* Waits like `BlockingQueue__dequeueWait`, then dequeues up to
+`maxElements` elements into `buffer` under one lock, so one wake-up
+serves a whole burst. The number dequeued is stored in `countAddr` */
+int8_t BlockingQueue__dequeueBatch(BlockingQueue *self,
+                                   void *buffer,
+                                   size_t maxElements,
+                                   uint64_t timeoutNanoseconds,
+                                   size_t *countAddr)
+{
+    char *output = buffer;
+    size_t count = 0;
+
+    *countAddr = 0;
+
+    if (maxElements == 0 || sBlockingQueue__waitNonEmpty(self, timeoutNanoseconds) == CBR_ERROR)
+    {
+        return CBR_ERROR;
+    }
+
+    while (count < maxElements && self->ring->numberOfElements > 0)
+    {
+        RingQueue__dequeue(self->ring, output + count * self->ring->elementSize);
+        count++;
+    }
+
+    atomic_store_explicit(&self->size, self->ring->numberOfElements, memory_order_relaxed);
+    pthread_mutex_unlock(&self->mutex);
+    *countAddr = count;
+
+    return CBR_SUCCESS;
+}
+
+/* Frees the queue, on which no thread may still be waiting */
+void BlockingQueue__del(BlockingQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    pthread_cond_destroy(&self->notEmpty);
+    pthread_mutex_destroy(&self->mutex);
+    RingQueue__del(self->ring);
+    free(self);
+}
@@ -0,0 +1,293 @@
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/_hash.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/bloomfilter.h>
+
+#define ADD_BATCH_SIZE 16
+#define BLOCK_ALIGNMENT 64
+/* "CBRBLOOM" followed by a format version */
+#define SERIAL_MAGIC 0x4d4f4f4c42524243ULL
+#define SERIAL_VERSION 1
+#define SERIAL_HEADER_SIZE 32
+#define LN2 0.69314718055994530942
+
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
+
+/* Picks the block from the high half of the hash by multiply-shift, which
+works for any number of blocks */
+static BloomFilterBlock *sBloomFilter__getBlock(BloomFilter *self, hash_t hash)
+{
+    return &self->blocks[((hash >> 32) * self->numberOfBlocks) >> 32];
+}
+
+/* Bit positions inside the block come from the low half of the hash by
+double hashing, the step being forced odd so positions never repeat early */
+static void sBloomFilterBlock__set(BloomFilterBlock *self, hash_t hash, uint8_t numberOfHashes)
+{
+    uint32_t position = (uint32_t)hash;
+    uint32_t step = ((position >> 17) | (position << 15)) | 1;
+
+    for (uint8_t i = 0; i < numberOfHashes; i++)
+    {
+        uint32_t bit = position % BLOOM_FILTER_BLOCK_BITS;
+        self->words[bit / 64] |= (uint64_t)1 << (bit % 64);
+        position += step;
+    }
+}
+
+static uint8_t sBloomFilterBlock__test(BloomFilterBlock *self, hash_t hash, uint8_t numberOfHashes)
+{
+    uint32_t position = (uint32_t)hash;
+    uint32_t step = ((position >> 17) | (position << 15)) | 1;
+
+    for (uint8_t i = 0; i < numberOfHashes; i++)
+    {
+        uint32_t bit = position % BLOOM_FILTER_BLOCK_BITS;
+
+        if (!(self->words[bit / 64] & ((uint64_t)1 << (bit % 64))))
+        {
+            return 0;
+        }
+
+        position += step;
+    }
+
+    return 1;
+}
+
+static BloomFilter *sBloomFilter__alloc(uint32_t numberOfBlocks, uint8_t numberOfHashes, uint64_t k0, uint64_t k1)
+{
+    BloomFilter *filter = malloc(sizeof(BloomFilter));
+
+    if (filter == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the Bloom filter\n");
+        return NULL;
+    }
+
+    filter->blocks = aligned_alloc(BLOCK_ALIGNMENT, sizeof(BloomFilterBlock) * numberOfBlocks);
+
+    if (filter->blocks == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the Bloom filter blocks\n");
+        free(filter);
+        return NULL;
+    }
+
+    memset(filter->blocks, 0, sizeof(BloomFilterBlock) * numberOfBlocks);
+    filter->k0 = k0;
+    filter->k1 = k1;
+    filter->numberOfBlocks = numberOfBlocks;
+    filter->numberOfHashes = numberOfHashes;
+
+    return filter;
+}
+
+/* Sizes the filter for `expectedItems` keys at `falsePositiveRate` using the
+classic m/n = -ln(p) / ln(2)^2 and k = m/n * ln(2). Confining keys to one
+block raises the rate a little, so a tenth more bits is given to make up for
+it. `k0` and `k1` key the hash of the unhashed API */
+BloomFilter *BloomFilter__new(size_t expectedItems,
+                              double falsePositiveRate,
+                              uint64_t k0,
+                              uint64_t k1)
+{
+    if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0))
+    {
+        fprintf(stderr, "Bloom filter false positive rate must be between 0 and 1\n");
+        return NULL;
+    }
+
+    double bitsPerItem = -log(falsePositiveRate) / (LN2 * LN2) * 1.1;
+    double blocks = ceil((expectedItems == 0 ? 1 : (double)expectedItems) * bitsPerItem / BLOOM_FILTER_BLOCK_BITS);
+    long hashes = lround(bitsPerItem / 1.1 * LN2);
+
+    if (blocks > UINT32_MAX)
+    {
+        fprintf(stderr, "Bloom filter is too large\n");
+        return NULL;
+    }
+
+    hashes = hashes < 1 ? 1 : hashes > BLOOM_FILTER_MAX_HASHES ? BLOOM_FILTER_MAX_HASHES : hashes;
+
+    return sBloomFilter__alloc((uint32_t)blocks, (uint8_t)hashes, k0, k1);
+}
+
+int8_t BloomFilter__add(BloomFilter *self, const void *key, size_t keySize)
+{
+    return BloomFilter__addHashed(self, hashBufferWithKey(self->k0, self->k1, key, keySize));
+}
+
+/* Adds a key already hashed by the caller, for instance with the same
+`hashBuffer` value used to probe a HashMap. Queries must then use
+`BloomFilter__mayContainHashed` with the same hash function */
+int8_t BloomFilter__addHashed(BloomFilter *self, hash_t hash)
+{
+    sBloomFilterBlock__set(sBloomFilter__getBlock(self, hash), hash, self->numberOfHashes);
+
+    return CBR_SUCCESS;
+}
+
+/* Adds `count` keys, hashing a batch first and prefetching its blocks so the
+cache misses overlap instead of being paid one after the other */
+int8_t BloomFilter__addBatch(BloomFilter *self,
+                             void **keys,
+                             const size_t *keySizes,
+                             size_t count)
+{
+    hash_t hashes[ADD_BATCH_SIZE];
+
+    for (size_t start = 0; start < count; start += ADD_BATCH_SIZE)
+    {
+        size_t batch = count - start < ADD_BATCH_SIZE ? count - start : ADD_BATCH_SIZE;
+
+        for (size_t i = 0; i < batch; i++)
+        {
+            hashes[i] = hashBufferWithKey(self->k0, self->k1, keys[start + i], keySizes[start + i]);
+            PREFETCH(sBloomFilter__getBlock(self, hashes[i]));
+        }
+
+        for (size_t i = 0; i < batch; i++)
+        {
+            sBloomFilterBlock__set(sBloomFilter__getBlock(self, hashes[i]), hashes[i], self->numberOfHashes);
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Returns 0 when the key was never added, 1 when it may have been */
+uint8_t BloomFilter__mayContain(BloomFilter *self, const void *key, size_t keySize)
+{
+    return BloomFilter__mayContainHashed(self, hashBufferWithKey(self->k0, self->k1, key, keySize));
+}
+
+uint8_t BloomFilter__mayContainHashed(BloomFilter *self, hash_t hash)
+{
+    return sBloomFilterBlock__test(sBloomFilter__getBlock(self, hash), hash, self->numberOfHashes);
+}
+
+static void sStoreUint64(unsigned char *buffer, uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        buffer[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint64_t sLoadUint64(const unsigned char *buffer)
+{
+    uint64_t value = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        value |= (uint64_t)buffer[i] << (8 * i);
+    }
+
+    return value;
+}
+
+size_t BloomFilter__serializedSize(BloomFilter *self)
+{
+    return SERIAL_HEADER_SIZE + sizeof(BloomFilterBlock) * self->numberOfBlocks;
+}
+
+/* Writes the filter in a little-endian format independent of the host:
+magic, version, number of hashes, number of blocks, hash key and the block
+words */
+int8_t BloomFilter__serialize(BloomFilter *self, void *buffer, size_t capacity)
+{
+    unsigned char *output = buffer;
+
+    if (capacity < BloomFilter__serializedSize(self))
+    {
+        fprintf(stderr, "Buffer is too small for the Bloom filter\n");
+        return CBR_ERROR;
+    }
+
+    sStoreUint64(output, SERIAL_MAGIC);
+    sStoreUint64(output + 8, (uint64_t)SERIAL_VERSION |
+                                 (uint64_t)self->numberOfHashes << 8 |
+                                 (uint64_t)self->numberOfBlocks << 32);
+    sStoreUint64(output + 16, self->k0);
+    sStoreUint64(output + 24, self->k1);
+    output += SERIAL_HEADER_SIZE;
+
+    for (uint32_t block = 0; block < self->numberOfBlocks; block++)
+    {
+        for (int word = 0; word < BLOOM_FILTER_BLOCK_WORDS; word++)
+        {
+            sStoreUint64(output, self->blocks[block].words[word]);
+            output += 8;
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+BloomFilter *BloomFilter__deserialize(const void *buffer, size_t size)
+{
+    const unsigned char *input = buffer;
+
+    if (size < SERIAL_HEADER_SIZE || sLoadUint64(input) != SERIAL_MAGIC)
+    {
+        fprintf(stderr, "Buffer does not hold a Bloom filter\n");
+        return NULL;
+    }
+
+    uint64_t layout = sLoadUint64(input + 8);
+    uint8_t numberOfHashes = (uint8_t)(layout >> 8);
+    uint32_t numberOfBlocks = (uint32_t)(layout >> 32);
+
+    if ((uint8_t)layout != SERIAL_VERSION ||
+        numberOfHashes == 0 || numberOfHashes > BLOOM_FILTER_MAX_HASHES ||
+        numberOfBlocks == 0 ||
+        (size - SERIAL_HEADER_SIZE) / sizeof(BloomFilterBlock) != numberOfBlocks ||
+        (size - SERIAL_HEADER_SIZE) % sizeof(BloomFilterBlock) != 0)
+    {
+        fprintf(stderr, "Unsupported or truncated Bloom filter\n");
+        return NULL;
+    }
+
+    BloomFilter *filter = sBloomFilter__alloc(numberOfBlocks,
+                                              numberOfHashes,
+                                              sLoadUint64(input + 16),
+                                              sLoadUint64(input + 24));
+
+    if (filter == NULL)
+    {
+        return NULL;
+    }
+
+    input += SERIAL_HEADER_SIZE;
+
+    for (uint32_t block = 0; block < numberOfBlocks; block++)
+    {
+        for (int word = 0; word < BLOOM_FILTER_BLOCK_WORDS; word++)
+        {
+            filter->blocks[block].words[word] = sLoadUint64(input);
+            input += 8;
+        }
+    }
+
+    return filter;
+}
+
+void BloomFilter__del(BloomFilter *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->blocks);
+    free(self);
+}
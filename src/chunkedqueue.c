@@ -0,0 +1,171 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/chunkedqueue.h>
+
+static ChunkedQueueBlock *sChunkedQueue__takeBlock(ChunkedQueue *self)
+{
+    ChunkedQueueBlock *block = self->freeBlocks;
+
+    if (block != NULL)
+    {
+        self->freeBlocks = block->next;
+        self->numberOfFreeBlocks--;
+    }
+    else
+    {
+        block = malloc(sizeof(ChunkedQueueBlock) + CHUNKED_QUEUE_BLOCK_ELEMENTS * self->elementSize);
+
+        if (block == NULL)
+        {
+            fprintf(stderr, "Failed to allocate memory for the chunked queue block\n");
+            return NULL;
+        }
+    }
+
+    block->next = NULL;
+
+    return block;
+}
+
+static void sChunkedQueue__releaseBlock(ChunkedQueue *self, ChunkedQueueBlock *block)
+{
+    if (self->numberOfFreeBlocks == CHUNKED_QUEUE_MAX_FREE_BLOCKS)
+    {
+        free(block);
+        return;
+    }
+
+    block->next = self->freeBlocks;
+    self->freeBlocks = block;
+    self->numberOfFreeBlocks++;
+}
+
+ChunkedQueue *ChunkedQueue__new(size_t elementSize)
+{
+    if (elementSize == 0)
+    {
+        fprintf(stderr, "Chunked queue element size must be positive\n");
+        return NULL;
+    }
+
+    ChunkedQueue *queue = malloc(sizeof(ChunkedQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the chunked queue\n");
+        return NULL;
+    }
+
+    queue->elementSize = elementSize;
+    queue->freeBlocks = NULL;
+    queue->numberOfFreeBlocks = 0;
+    queue->head = sChunkedQueue__takeBlock(queue);
+
+    if (queue->head == NULL)
+    {
+        free(queue);
+        return NULL;
+    }
+
+    queue->tail = queue->head;
+    queue->headIndex = 0;
+    queue->tailIndex = 0;
+    queue->numberOfElements = 0;
+
+    return queue;
+}
+
+int8_t ChunkedQueue__enqueue(ChunkedQueue *self, const void *value)
+{
+    if (self->tailIndex == CHUNKED_QUEUE_BLOCK_ELEMENTS)
+    {
+        ChunkedQueueBlock *block = sChunkedQueue__takeBlock(self);
+
+        if (block == NULL)
+        {
+            return CBR_ERROR;
+        }
+
+        self->tail->next = block;
+        self->tail = block;
+        self->tailIndex = 0;
+    }
+
+    memcpy(self->tail->elements + self->tailIndex * self->elementSize, value, self->elementSize);
+    self->tailIndex++;
+    self->numberOfElements++;
+
+    return CBR_SUCCESS;
+}
+
+/* Copies the head element into `buffer` and removes it */
+int8_t ChunkedQueue__dequeue(ChunkedQueue *self, void *buffer)
+{
+    if (self->numberOfElements == 0)
+    {
+        fprintf(stderr, "Empty queue\n");
+        return CBR_ERROR;
+    }
+
+    memcpy(buffer, self->head->elements + self->headIndex * self->elementSize, self->elementSize);
+    self->headIndex++;
+    self->numberOfElements--;
+
+    if (self->numberOfElements == 0)
+    {
+        // Rewind instead of moving on, so a queue hovering around empty
+        // keeps using a single block
+        self->headIndex = 0;
+        self->tailIndex = 0;
+    }
+    else if (self->headIndex == CHUNKED_QUEUE_BLOCK_ELEMENTS)
+    {
+        ChunkedQueueBlock *block = self->head;
+        self->head = block->next;
+        self->headIndex = 0;
+        sChunkedQueue__releaseBlock(self, block);
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Stores the head element in `valueAddr`, borrowed until it is dequeued */
+int8_t ChunkedQueue__peek(ChunkedQueue *self, void **valueAddr)
+{
+    if (self->numberOfElements == 0)
+    {
+        fprintf(stderr, "Empty queue\n");
+        return CBR_ERROR;
+    }
+
+    *valueAddr = self->head->elements + self->headIndex * self->elementSize;
+
+    return CBR_SUCCESS;
+}
+
+void ChunkedQueue__del(ChunkedQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    ChunkedQueueBlock *lists[2] = {self->head, self->freeBlocks};
+
+    for (int i = 0; i < 2; i++)
+    {
+        ChunkedQueueBlock *block = lists[i];
+
+        while (block != NULL)
+        {
+            ChunkedQueueBlock *next = block->next;
+            free(block);
+            block = next;
+        }
+    }
+
+    free(self);
+}
@@ -0,0 +1,165 @@
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/_hash.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/countmin.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define COUNTER_ALIGNMENT 16
+#define MIN_WIDTH 16
+
+/* Row `row` uses the column h1 + row * h2 of a single 64-bit hash, split in
+two halves, instead of `depth` independent hashes */
+static size_t sCountMinSketch__column(const CountMinSketch *self, hash_t hash, uint8_t row)
+{
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+
+    return (size_t)(h1 + (uint32_t)row * h2) & (self->width - 1);
+}
+
+/* Sizes the sketch as width = e / epsilon, rounded up to a power of two,
+and depth = ln(1 / delta). `k0` and `k1` key the SipHash of the unhashed API
+and must match between sketches that are merged, on any host */
+CountMinSketch *CountMinSketch__new(double epsilon, double delta, uint64_t k0, uint64_t k1)
+{
+    if (!(epsilon > 0.0 && epsilon < 1.0 && delta > 0.0 && delta < 1.0))
+    {
+        fprintf(stderr, "Count-Min epsilon and delta must be between 0 and 1\n");
+        return NULL;
+    }
+
+    double rawDepth = ceil(log(1.0 / delta));
+    uint8_t depth = rawDepth < 1 ? 1 : rawDepth > COUNT_MIN_MAX_DEPTH ? COUNT_MIN_MAX_DEPTH : (uint8_t)rawDepth;
+    double target = ceil(exp(1.0) / epsilon);
+    size_t maxWidth = SIZE_MAX / (depth * sizeof(uint64_t));
+    size_t width = MIN_WIDTH;
+
+    while ((double)width < target)
+    {
+        if (width > maxWidth / 2)
+        {
+            fprintf(stderr, "Count-Min epsilon is too small for the counters to fit in memory\n");
+            return NULL;
+        }
+
+        width <<= 1;
+    }
+
+    CountMinSketch *sketch = malloc(sizeof(CountMinSketch));
+
+    if (sketch == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the Count-Min sketch\n");
+        return NULL;
+    }
+
+    sketch->k0 = k0;
+    sketch->k1 = k1;
+    sketch->width = width;
+    sketch->depth = depth;
+    sketch->total = 0;
+    sketch->counters = aligned_alloc(COUNTER_ALIGNMENT, sizeof(uint64_t) * width * sketch->depth);
+
+    if (sketch->counters == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the Count-Min counters\n");
+        free(sketch);
+        return NULL;
+    }
+
+    memset(sketch->counters, 0, sizeof(uint64_t) * width * sketch->depth);
+
+    return sketch;
+}
+
+int8_t CountMinSketch__add(CountMinSketch *self, const void *key, size_t keySize, uint64_t count)
+{
+    return CountMinSketch__addHashed(self, hashBufferWithKey(self->k0, self->k1, key, keySize), count);
+}
+
+int8_t CountMinSketch__addHashed(CountMinSketch *self, hash_t hash, uint64_t count)
+{
+    for (uint8_t row = 0; row < self->depth; row++)
+    {
+        self->counters[row * self->width + sCountMinSketch__column(self, hash, row)] += count;
+    }
+
+    self->total += count;
+
+    return CBR_SUCCESS;
+}
+
+uint64_t CountMinSketch__estimate(const CountMinSketch *self, const void *key, size_t keySize)
+{
+    return CountMinSketch__estimateHashed(self, hashBufferWithKey(self->k0, self->k1, key, keySize));
+}
+
+/* Smallest counter of the key across rows. A key is a heavy hitter for a
+fraction phi when this reaches phi * `total` */
+uint64_t CountMinSketch__estimateHashed(const CountMinSketch *self, hash_t hash)
+{
+    uint64_t estimate = UINT64_MAX;
+
+    for (uint8_t row = 0; row < self->depth; row++)
+    {
+        uint64_t counter = self->counters[row * self->width + sCountMinSketch__column(self, hash, row)];
+
+        if (counter < estimate)
+        {
+            estimate = counter;
+        }
+    }
+
+    return estimate;
+}
+
+/* Adds the counters of `other` into `self`, two at a time with SSE2. The
+result is the sketch of both streams */
+int8_t CountMinSketch__merge(CountMinSketch *self, const CountMinSketch *other)
+{
+    if (self->width != other->width || self->depth != other->depth ||
+        self->k0 != other->k0 || self->k1 != other->k1)
+    {
+        fprintf(stderr, "Count-Min sketches have different parameters\n");
+        return CBR_ERROR;
+    }
+
+    size_t numberOfCounters = self->width * self->depth;
+
+#if defined(__SSE2__)
+    // The width is a power of two of at least 16, so there is no odd tail
+    for (size_t i = 0; i < numberOfCounters; i += 2)
+    {
+        __m128i mine = _mm_load_si128((const __m128i *)(self->counters + i));
+        __m128i theirs = _mm_load_si128((const __m128i *)(other->counters + i));
+        _mm_store_si128((__m128i *)(self->counters + i), _mm_add_epi64(mine, theirs));
+    }
+#else
+    for (size_t i = 0; i < numberOfCounters; i++)
+    {
+        self->counters[i] += other->counters[i];
+    }
+#endif
+
+    self->total += other->total;
+
+    return CBR_SUCCESS;
+}
+
+void CountMinSketch__del(CountMinSketch *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->counters);
+    free(self);
+}
@@ -0,0 +1,128 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/eventqueue.h>
+#include <cbarroso/ringqueue.h>
+
+EventQueue *EventQueue__new(size_t elementSize)
+{
+    EventQueue *queue = malloc(sizeof(EventQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the event queue\n");
+        return NULL;
+    }
+
+    queue->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (queue->eventFd < 0)
+    {
+        fprintf(stderr, "Failed to create the event queue eventfd\n");
+        free(queue);
+        return NULL;
+    }
+
+    queue->ring = RingQueue__new(elementSize, 0);
+
+    if (queue->ring == NULL)
+    {
+        close(queue->eventFd);
+        free(queue);
+        return NULL;
+    }
+
+    pthread_mutex_init(&queue->mutex, NULL);
+    queue->signalled = 0;
+
+    return queue;
+}
+
+/* Copies `value` into the queue from any thread. Only the first enqueue
+after the queue was emptied writes to the eventfd, under the mutex so that a
+drain can never reset the eventfd before the write lands */
+int8_t EventQueue__enqueue(EventQueue *self, const void *value)
+{
+    pthread_mutex_lock(&self->mutex);
+
+    if (RingQueue__enqueue(self->ring, value) == CBR_ERROR)
+    {
+        pthread_mutex_unlock(&self->mutex);
+        return CBR_ERROR;
+    }
+
+    if (!self->signalled)
+    {
+        uint64_t one = 1;
+
+        if (write(self->eventFd, &one, sizeof(one)) != sizeof(one))
+        {
+            // Take the element back, nothing would wake the loop for it
+            self->ring->numberOfElements--;
+            pthread_mutex_unlock(&self->mutex);
+            fprintf(stderr, "Failed to signal the event queue eventfd\n");
+            return CBR_ERROR;
+        }
+
+        self->signalled = 1;
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+
+    return CBR_SUCCESS;
+}
+
+/* Dequeues up to `maxElements` elements into `buffer` and stores how many in
+`countAddr`. Called by the loop thread when `eventFd` is readable. The
+eventfd is only reset once the queue is empty, so elements left over by a
+partial drain keep it readable */
+int8_t EventQueue__drain(EventQueue *self, void *buffer, size_t maxElements, size_t *countAddr)
+{
+    char *output = buffer;
+    size_t count = 0;
+
+    pthread_mutex_lock(&self->mutex);
+
+    while (count < maxElements && self->ring->numberOfElements > 0)
+    {
+        RingQueue__dequeue(self->ring, output + count * self->ring->elementSize);
+        count++;
+    }
+
+    if (self->ring->numberOfElements == 0 && self->signalled)
+    {
+        uint64_t counter;
+
+        // Cannot fail, the write happened under the mutex
+        if (read(self->eventFd, &counter, sizeof(counter)) < 0)
+        {
+            counter = 0;
+        }
+
+        self->signalled = 0;
+    }
+
+    pthread_mutex_unlock(&self->mutex);
+    *countAddr = count;
+
+    return CBR_SUCCESS;
+}
+
+/* Closes the eventfd and frees the queue, which must be removed from any
+epoll set first */
+void EventQueue__del(EventQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    close(self->eventFd);
+    pthread_mutex_destroy(&self->mutex);
+    RingQueue__del(self->ring);
+    free(self);
+}
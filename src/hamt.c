@@ -0,0 +1,642 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/_hash.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/hamt.h>
+
+#define HAMT_MASK (HAMT_WIDTH - 1)
+/* Values are stored after the key at an offset rounded up to this, so they
+can be read in place whatever their type */
+#define VALUE_ALIGNMENT 16
+#define VALUE_OFFSET(keySize) (((keySize) + VALUE_ALIGNMENT - 1) & ~(size_t)(VALUE_ALIGNMENT - 1))
+
+static uint8_t sPopCount(uint32_t bits)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_popcount(bits);
+#else
+    uint8_t count = 0;
+
+    for (; bits != 0; bits &= bits - 1)
+    {
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+static HamtNode *sHamtNode__incref(HamtNode *self)
+{
+    atomic_fetch_add_explicit(&self->refcount, 1, memory_order_relaxed);
+    return self;
+}
+
+static void sHamtNode__decref(HamtNode *self)
+{
+    if (self == NULL ||
+        atomic_fetch_sub_explicit(&self->refcount, 1, memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    if (self->kind == HAMT_BRANCH)
+    {
+        HamtBranch *branch = (HamtBranch *)self;
+        uint8_t count = sPopCount(branch->bitmap);
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            sHamtNode__decref(branch->children[i]);
+        }
+    }
+    else if (self->kind == HAMT_COLLISION)
+    {
+        HamtCollision *collision = (HamtCollision *)self;
+
+        for (uint32_t i = 0; i < collision->count; i++)
+        {
+            sHamtNode__decref(collision->children[i]);
+        }
+    }
+
+    free(self);
+}
+
+static hash_t sHamtNode__getHash(HamtNode *self)
+{
+    return self->kind == HAMT_LEAF ? ((HamtLeaf *)self)->hash : ((HamtCollision *)self)->hash;
+}
+
+static uint8_t sHamtLeaf__hasKey(HamtLeaf *self, void *key, size_t keySize, hash_t hash)
+{
+    return self->hash == hash &&
+           self->keySize == keySize &&
+           memcmp(self->data, key, keySize) == 0;
+}
+
+static HamtLeaf *sHamtLeaf__new(void *key,
+                                size_t keySize,
+                                hash_t hash,
+                                void *value,
+                                size_t valueSize)
+{
+    HamtLeaf *leaf = malloc(sizeof(HamtLeaf) + VALUE_OFFSET(keySize) + valueSize);
+
+    if (leaf == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the HAMT leaf\n");
+        return NULL;
+    }
+
+    atomic_init(&leaf->header.refcount, 1);
+    leaf->header.kind = HAMT_LEAF;
+    leaf->hash = hash;
+    leaf->keySize = keySize;
+    leaf->valueSize = valueSize;
+    memcpy(leaf->data, key, keySize);
+    memcpy(leaf->data + VALUE_OFFSET(keySize), value, valueSize);
+
+    return leaf;
+}
+
+static HamtBranch *sHamtBranch__new(uint32_t bitmap)
+{
+    HamtBranch *branch = malloc(sizeof(HamtBranch) + sizeof(HamtNode *) * sPopCount(bitmap));
+
+    if (branch == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the HAMT branch\n");
+        return NULL;
+    }
+
+    atomic_init(&branch->header.refcount, 1);
+    branch->header.kind = HAMT_BRANCH;
+    branch->bitmap = bitmap;
+
+    return branch;
+}
+
+static HamtCollision *sHamtCollision__new(hash_t hash, uint32_t count)
+{
+    HamtCollision *collision = malloc(sizeof(HamtCollision) + sizeof(HamtNode *) * count);
+
+    if (collision == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the HAMT collision node\n");
+        return NULL;
+    }
+
+    atomic_init(&collision->header.refcount, 1);
+    collision->header.kind = HAMT_COLLISION;
+    collision->hash = hash;
+    collision->count = count;
+
+    return collision;
+}
+
+/* Copies `self` with the child at `position` replaced by `child`, or removed
+when `child` is `NULL` and `bit` is cleared from the bitmap */
+static HamtNode *sHamtBranch__copyWith(HamtBranch *self, uint8_t position, HamtNode *child, uint32_t bit)
+{
+    uint32_t bitmap = child == NULL ? self->bitmap & ~bit : self->bitmap;
+    HamtBranch *copy = sHamtBranch__new(bitmap);
+
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+
+    uint8_t count = sPopCount(self->bitmap);
+    uint8_t target = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (i == position)
+        {
+            if (child != NULL)
+            {
+                copy->children[target++] = child;
+            }
+
+            continue;
+        }
+
+        copy->children[target++] = sHamtNode__incref(self->children[i]);
+    }
+
+    return (HamtNode *)copy;
+}
+
+/* Builds the smallest subtree holding both `existing`, borrowed, and
+`added`, owned, below the level at `shift`. `added` is released on failure */
+static HamtNode *sHamt__mergeNodes(HamtNode *existing, HamtNode *added, uint8_t shift)
+{
+    hash_t existingHash = sHamtNode__getHash(existing);
+    hash_t addedHash = sHamtNode__getHash(added);
+
+    if (existingHash == addedHash)
+    {
+        HamtCollision *collision = sHamtCollision__new(addedHash, 2);
+
+        if (collision == NULL)
+        {
+            sHamtNode__decref(added);
+            return NULL;
+        }
+
+        collision->children[0] = sHamtNode__incref(existing);
+        collision->children[1] = added;
+
+        return (HamtNode *)collision;
+    }
+
+    uint32_t existingFragment = (existingHash >> shift) & HAMT_MASK;
+    uint32_t addedFragment = (addedHash >> shift) & HAMT_MASK;
+
+    if (existingFragment == addedFragment)
+    {
+        HamtNode *child = sHamt__mergeNodes(existing, added, shift + HAMT_BITS);
+
+        if (child == NULL)
+        {
+            return NULL;
+        }
+
+        HamtBranch *branch = sHamtBranch__new((uint32_t)1 << existingFragment);
+
+        if (branch == NULL)
+        {
+            sHamtNode__decref(child);
+            return NULL;
+        }
+
+        branch->children[0] = child;
+
+        return (HamtNode *)branch;
+    }
+
+    HamtBranch *branch = sHamtBranch__new(((uint32_t)1 << existingFragment) |
+                                          ((uint32_t)1 << addedFragment));
+
+    if (branch == NULL)
+    {
+        sHamtNode__decref(added);
+        return NULL;
+    }
+
+    uint8_t addedFirst = addedFragment < existingFragment;
+    branch->children[addedFirst ? 0 : 1] = added;
+    branch->children[addedFirst ? 1 : 0] = sHamtNode__incref(existing);
+
+    return (HamtNode *)branch;
+}
+
+/* Returns a copy of the path from `self` down to where `leaf` belongs, with
+`leaf` in place. Everything off that path is shared with `self`. `leaf` is
+owned by the call, even on failure, and `addedAddr` tells whether the key was
+new */
+static HamtNode *sHamt__set(HamtNode *self, uint8_t shift, HamtLeaf *leaf, uint8_t *addedAddr)
+{
+    if (self->kind == HAMT_LEAF)
+    {
+        HamtLeaf *existing = (HamtLeaf *)self;
+
+        if (sHamtLeaf__hasKey(existing, leaf->data, leaf->keySize, leaf->hash))
+        {
+            *addedAddr = 0;
+            return (HamtNode *)leaf;
+        }
+
+        *addedAddr = 1;
+        return sHamt__mergeNodes(self, (HamtNode *)leaf, shift);
+    }
+
+    if (self->kind == HAMT_COLLISION)
+    {
+        HamtCollision *collision = (HamtCollision *)self;
+
+        if (collision->hash != leaf->hash)
+        {
+            *addedAddr = 1;
+            return sHamt__mergeNodes(self, (HamtNode *)leaf, shift);
+        }
+
+        uint32_t position = collision->count;
+
+        for (uint32_t i = 0; i < collision->count; i++)
+        {
+            if (sHamtLeaf__hasKey((HamtLeaf *)collision->children[i], leaf->data, leaf->keySize, leaf->hash))
+            {
+                position = i;
+            }
+        }
+
+        *addedAddr = position == collision->count;
+        HamtCollision *copy = sHamtCollision__new(collision->hash, collision->count + *addedAddr);
+
+        if (copy == NULL)
+        {
+            free(leaf);
+            return NULL;
+        }
+
+        for (uint32_t i = 0; i < collision->count; i++)
+        {
+            copy->children[i] = i == position ? (HamtNode *)leaf : sHamtNode__incref(collision->children[i]);
+        }
+
+        if (*addedAddr)
+        {
+            copy->children[collision->count] = (HamtNode *)leaf;
+        }
+
+        return (HamtNode *)copy;
+    }
+
+    HamtBranch *branch = (HamtBranch *)self;
+    uint32_t bit = (uint32_t)1 << ((leaf->hash >> shift) & HAMT_MASK);
+    uint8_t position = sPopCount(branch->bitmap & (bit - 1));
+
+    if (branch->bitmap & bit)
+    {
+        HamtNode *child = sHamt__set(branch->children[position], shift + HAMT_BITS, leaf, addedAddr);
+
+        if (child == NULL)
+        {
+            return NULL;
+        }
+
+        HamtNode *copy = sHamtBranch__copyWith(branch, position, child, bit);
+
+        if (copy == NULL)
+        {
+            sHamtNode__decref(child);
+        }
+
+        return copy;
+    }
+
+    HamtBranch *copy = sHamtBranch__new(branch->bitmap | bit);
+
+    if (copy == NULL)
+    {
+        free(leaf);
+        return NULL;
+    }
+
+    uint8_t count = sPopCount(branch->bitmap);
+
+    for (uint8_t i = 0, target = 0; i <= count; i++)
+    {
+        if (i == position)
+        {
+            copy->children[target++] = (HamtNode *)leaf;
+        }
+
+        if (i < count)
+        {
+            copy->children[target++] = sHamtNode__incref(branch->children[i]);
+        }
+    }
+
+    *addedAddr = 1;
+
+    return (HamtNode *)copy;
+}
+
+/* Looks for the key below `self` and, when found, stores in `resultAddr` the
+copy of `self` without it, `NULL` if nothing is left. Returns 1 if the key was
+found, 0 if not and -1 on allocation failure */
+static int8_t sHamt__remove(HamtNode *self,
+                            uint8_t shift,
+                            void *key,
+                            size_t keySize,
+                            hash_t hash,
+                            HamtNode **resultAddr)
+{
+    if (self->kind == HAMT_LEAF)
+    {
+        if (!sHamtLeaf__hasKey((HamtLeaf *)self, key, keySize, hash))
+        {
+            return 0;
+        }
+
+        *resultAddr = NULL;
+        return 1;
+    }
+
+    if (self->kind == HAMT_COLLISION)
+    {
+        HamtCollision *collision = (HamtCollision *)self;
+        uint32_t position = collision->count;
+
+        for (uint32_t i = 0; i < collision->count && collision->hash == hash; i++)
+        {
+            if (sHamtLeaf__hasKey((HamtLeaf *)collision->children[i], key, keySize, hash))
+            {
+                position = i;
+            }
+        }
+
+        if (position == collision->count)
+        {
+            return 0;
+        }
+
+        if (collision->count == 2)
+        {
+            *resultAddr = sHamtNode__incref(collision->children[1 - position]);
+            return 1;
+        }
+
+        HamtCollision *copy = sHamtCollision__new(collision->hash, collision->count - 1);
+
+        if (copy == NULL)
+        {
+            return CBR_ERROR;
+        }
+
+        for (uint32_t i = 0, target = 0; i < collision->count; i++)
+        {
+            if (i != position)
+            {
+                copy->children[target++] = sHamtNode__incref(collision->children[i]);
+            }
+        }
+
+        *resultAddr = (HamtNode *)copy;
+        return 1;
+    }
+
+    HamtBranch *branch = (HamtBranch *)self;
+    uint32_t bit = (uint32_t)1 << ((hash >> shift) & HAMT_MASK);
+
+    if (!(branch->bitmap & bit))
+    {
+        return 0;
+    }
+
+    uint8_t position = sPopCount(branch->bitmap & (bit - 1));
+    uint8_t count = sPopCount(branch->bitmap);
+    HamtNode *child = NULL;
+    int8_t found = sHamt__remove(branch->children[position], shift + HAMT_BITS, key, keySize, hash, &child);
+
+    if (found != 1)
+    {
+        return found;
+    }
+
+    // Leaves and collision nodes can sit at any depth along their hash path,
+    // so a branch left with one of them alone is replaced by it
+    if (child == NULL && count == 1)
+    {
+        *resultAddr = NULL;
+        return 1;
+    }
+
+    if (child == NULL && count == 2 && branch->children[1 - position]->kind != HAMT_BRANCH)
+    {
+        *resultAddr = sHamtNode__incref(branch->children[1 - position]);
+        return 1;
+    }
+
+    if (child != NULL && count == 1 && child->kind != HAMT_BRANCH)
+    {
+        *resultAddr = child;
+        return 1;
+    }
+
+    *resultAddr = sHamtBranch__copyWith(branch, position, child, bit);
+
+    if (*resultAddr == NULL)
+    {
+        sHamtNode__decref(child);
+        return CBR_ERROR;
+    }
+
+    return 1;
+}
+
+static Hamt *sHamt__wrap(HamtNode *root, size_t count)
+{
+    Hamt *hamt = malloc(sizeof(Hamt));
+
+    if (hamt == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the HAMT\n");
+        sHamtNode__decref(root);
+        return NULL;
+    }
+
+    atomic_init(&hamt->refcount, 1);
+    hamt->root = root;
+    hamt->count = count;
+
+    return hamt;
+}
+
+Hamt *Hamt__new(void)
+{
+    return sHamt__wrap(NULL, 0);
+}
+
+/* Returns a new version of the map with `key` set to `value`, leaving `self`
+untouched. Only the O(log32 n) nodes on the path to the key are copied */
+Hamt *Hamt__set(const Hamt *self,
+                void *key,
+                size_t keySize,
+                void *value,
+                size_t valueSize)
+{
+    return Hamt__setHashed(self, key, keySize, hashBuffer(key, keySize), value, valueSize);
+}
+
+/* Same as `Hamt__set` for a key already hashed */
+Hamt *Hamt__setHashed(const Hamt *self,
+                      void *key,
+                      size_t keySize,
+                      hash_t hash,
+                      void *value,
+                      size_t valueSize)
+{
+    HamtLeaf *leaf = sHamtLeaf__new(key, keySize, hash, value, valueSize);
+
+    if (leaf == NULL)
+    {
+        return NULL;
+    }
+
+    if (self->root == NULL)
+    {
+        return sHamt__wrap((HamtNode *)leaf, 1);
+    }
+
+    uint8_t added = 0;
+    HamtNode *root = sHamt__set(self->root, 0, leaf, &added);
+
+    if (root == NULL)
+    {
+        return NULL;
+    }
+
+    return sHamt__wrap(root, self->count + added);
+}
+
+int8_t Hamt__get(const Hamt *self, void *key, size_t keySize, void **valueAddr)
+{
+    return Hamt__getHashed(self, key, keySize, hashBuffer(key, keySize), valueAddr);
+}
+
+/* Same as `Hamt__get` for a key already hashed. The value is borrowed from
+the version and stays valid as long as it does */
+int8_t Hamt__getHashed(const Hamt *self,
+                       void *key,
+                       size_t keySize,
+                       hash_t hash,
+                       void **valueAddr)
+{
+    HamtNode *node = self->root;
+    uint8_t shift = 0;
+
+    *valueAddr = NULL;
+
+    while (node != NULL)
+    {
+        if (node->kind == HAMT_LEAF)
+        {
+            HamtLeaf *leaf = (HamtLeaf *)node;
+
+            if (sHamtLeaf__hasKey(leaf, key, keySize, hash))
+            {
+                *valueAddr = leaf->data + VALUE_OFFSET(keySize);
+            }
+
+            return CBR_SUCCESS;
+        }
+
+        if (node->kind == HAMT_COLLISION)
+        {
+            HamtCollision *collision = (HamtCollision *)node;
+
+            for (uint32_t i = 0; i < collision->count; i++)
+            {
+                HamtLeaf *leaf = (HamtLeaf *)collision->children[i];
+
+                if (sHamtLeaf__hasKey(leaf, key, keySize, hash))
+                {
+                    *valueAddr = leaf->data + VALUE_OFFSET(keySize);
+                }
+            }
+
+            return CBR_SUCCESS;
+        }
+
+        HamtBranch *branch = (HamtBranch *)node;
+        uint32_t bit = (uint32_t)1 << ((hash >> shift) & HAMT_MASK);
+
+        if (!(branch->bitmap & bit))
+        {
+            return CBR_SUCCESS;
+        }
+
+        node = branch->children[sPopCount(branch->bitmap & (bit - 1))];
+        shift += HAMT_BITS;
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Returns a new version of the map without `key`, leaving `self` untouched.
+When the key is absent the new version shares the whole tree with `self` */
+Hamt *Hamt__remove(const Hamt *self, void *key, size_t keySize)
+{
+    return Hamt__removeHashed(self, key, keySize, hashBuffer(key, keySize));
+}
+
+/* Same as `Hamt__remove` for a key already hashed */
+Hamt *Hamt__removeHashed(const Hamt *self, void *key, size_t keySize, hash_t hash)
+{
+    HamtNode *root = NULL;
+    int8_t found = self->root == NULL
+                       ? 0
+                       : sHamt__remove(self->root, 0, key, keySize, hash, &root);
+
+    if (found == CBR_ERROR)
+    {
+        return NULL;
+    }
+
+    if (found == 0)
+    {
+        return sHamt__wrap(self->root == NULL ? NULL : sHamtNode__incref(self->root), self->count);
+    }
+
+    return sHamt__wrap(root, self->count - 1);
+}
+
+/* Takes another reference to the version in O(1). Each reference, including
+the one returned by the constructor, is released with `Hamt__del`. Hand a
+snapshot to a reader thread before releasing the writer's reference */
+Hamt *Hamt__snapshot(Hamt *self)
+{
+    atomic_fetch_add_explicit(&self->refcount, 1, memory_order_relaxed);
+    return self;
+}
+
+/* Releases a reference to the version. The last one frees the nodes no
+other version shares */
+void Hamt__del(Hamt *self)
+{
+    if (self == NULL ||
+        atomic_fetch_sub_explicit(&self->refcount, 1, memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    sHamtNode__decref(self->root);
+    free(self);
+}
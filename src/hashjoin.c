@@ -0,0 +1,198 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/_hash.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/hashmap.h>
+#include <cbarroso/hashjoin.h>
+
+/* Number of probe keys hashed and prefetched ahead of their lookups */
+#define PROBE_BATCH_SIZE 16
+#define MIN_ROWS_CAPACITY 16
+
+HashJoin *HashJoin__new(uint8_t log2_size)
+{
+    HashJoin *join = malloc(sizeof(HashJoin));
+
+    if (join == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the hash join\n");
+        return NULL;
+    }
+
+    join->heads = HashMap__new(log2_size);
+
+    if (join->heads == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the hash join keys\n");
+        free(join);
+        return NULL;
+    }
+
+    join->rows = NULL;
+    join->numberOfRows = 0;
+    join->capacity = 0;
+
+    return join;
+}
+
+/* Pushes the current head of the key down the chain and makes the new row
+the head */
+static void sHashJoin__chainRow(void *value, const void *delta, size_t valueSize, void *context)
+{
+    (void)valueSize;
+    ssize_t *next = context;
+    *next = *(ssize_t *)value;
+    *(ssize_t *)value = *(const ssize_t *)delta;
+}
+
+/* Adds a build-side row. Rows sharing a key are chained together rather
+than overwriting each other */
+int8_t HashJoin__build(HashJoin *self, void *key, size_t keySize, size_t rowId)
+{
+    if (self->numberOfRows == self->capacity)
+    {
+        size_t newCapacity = self->capacity > 0 ? self->capacity * 2 : MIN_ROWS_CAPACITY;
+        HashJoinRow *newRows = realloc(self->rows, sizeof(HashJoinRow) * newCapacity);
+
+        if (newRows == NULL)
+        {
+            fprintf(stderr, "Failed to allocate memory for the hash join rows\n");
+            return CBR_ERROR;
+        }
+
+        self->rows = newRows;
+        self->capacity = newCapacity;
+    }
+
+    ssize_t position = (ssize_t)self->numberOfRows;
+    HashJoinRow *row = &self->rows[position];
+    row->rowId = rowId;
+    row->next = -1;
+
+    int8_t result = HashMap__mergeWith(self->heads,
+                                       key,
+                                       keySize,
+                                       &position,
+                                       sizeof(ssize_t),
+                                       sHashJoin__chainRow,
+                                       &row->next,
+                                       NULL);
+
+    if (result == CBR_ERROR)
+    {
+        return CBR_ERROR;
+    }
+
+    self->numberOfRows++;
+
+    return CBR_SUCCESS;
+}
+
+void HashJoinCursor__reset(HashJoinCursor *self)
+{
+    self->position = 0;
+    self->chain = -1;
+}
+
+static size_t sHashJoin__emitChain(HashJoin *self,
+                                   HashJoinCursor *cursor,
+                                   HashJoinMatch *matches,
+                                   size_t numberOfMatches,
+                                   size_t capacity)
+{
+    while (cursor->chain >= 0 && numberOfMatches < capacity)
+    {
+        matches[numberOfMatches].buildRow = self->rows[cursor->chain].rowId;
+        matches[numberOfMatches].probeRow = cursor->position;
+        numberOfMatches++;
+        cursor->chain = self->rows[cursor->chain].next;
+    }
+
+    return numberOfMatches;
+}
+
+/* Probes `count` keys against the build side, writing up to `capacity`
+matched pairs into `matches` and returning how many were written. When the
+buffer fills up, `cursor` records where to resume; the batch is done once
+`cursor->position` reaches `count`. Keys are hashed and their index slots
+prefetched in groups so their cache misses overlap */
+size_t HashJoin__probeBatch(HashJoin *self,
+                            void **keys,
+                            const size_t *keySizes,
+                            size_t count,
+                            HashJoinMatch *matches,
+                            size_t capacity,
+                            HashJoinCursor *cursor)
+{
+    hash_t hashes[PROBE_BATCH_SIZE];
+    size_t numberOfMatches = 0;
+
+    // Finish the key left over by the previous call
+    if (cursor->chain >= 0)
+    {
+        numberOfMatches = sHashJoin__emitChain(self, cursor, matches, 0, capacity);
+
+        if (cursor->chain >= 0)
+        {
+            return numberOfMatches;
+        }
+
+        cursor->position++;
+    }
+
+    while (cursor->position < count && numberOfMatches < capacity)
+    {
+        size_t start = cursor->position;
+        size_t batchSize = count - start < PROBE_BATCH_SIZE ? count - start : PROBE_BATCH_SIZE;
+
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            hashes[i] = hashBuffer(keys[start + i], keySizes[start + i]);
+            HashMap__prefetch(self->heads, hashes[i]);
+        }
+
+        for (size_t i = 0; i < batchSize && numberOfMatches < capacity; i++)
+        {
+            void *head = NULL;
+            HashMap__getItemHashed(self->heads,
+                                   keys[start + i],
+                                   keySizes[start + i],
+                                   hashes[i],
+                                   &head);
+            cursor->position = start + i;
+
+            if (head != NULL)
+            {
+                cursor->chain = *(ssize_t *)head;
+                numberOfMatches = sHashJoin__emitChain(self,
+                                                       cursor,
+                                                       matches,
+                                                       numberOfMatches,
+                                                       capacity);
+
+                if (cursor->chain >= 0)
+                {
+                    return numberOfMatches;
+                }
+            }
+
+            cursor->position++;
+        }
+    }
+
+    return numberOfMatches;
+}
+
+void HashJoin__del(HashJoin *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    HashMap__del(self->heads);
+    free(self->rows);
+    free(self);
+}
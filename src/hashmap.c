@@ -15,6 +15,21 @@
 
 #define USABLE_FRACTION(n) (((n) << 1) / 3)
 
+/* Number of keys hashed and prefetched ahead of the merges in a batch */
+#define MERGE_BATCH_SIZE 16
+
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
+
+#ifdef CBR_HASHMAP_COUNTERS
+#define HASHMAP_COUNT(self, counter, n) ((self)->counter += (n))
+#else
+#define HASHMAP_COUNT(self, counter, n) ((void)0)
+#endif
+
 static ssize_t sHashMap__getIndex(HashMap *self, ssize_t maskedHash)
 {
     if (self->log2_size < 8)
@@ -37,7 +52,7 @@ static ssize_t sHashMap__getIndex(HashMap *self, ssize_t maskedHash)
 
 HashMapEntry **HashMap__getEntries(HashMap *self)
 {
-    return (HashMapEntry **)(&self->indices[1 << self->log2_index_bytes]);
+    return (HashMapEntry **)(&self->indices[(size_t)1 << self->log2_index_bytes]);
 }
 
 static size_t sHashMap__getMask(HashMap *self)
@@ -45,8 +60,15 @@ static size_t sHashMap__getMask(HashMap *self)
     return ((int64_t)1 << self->log2_size) - 1;
 }
 
-static ssize_t sHashMap__doLookup(HashMap *self, void *key, size_t keySize, hash_t hash)
+/* Walks the probe chain of `hash`, storing in `probesAddr` how many index
+slots were visited */
+static ssize_t sHashMap__probeLookup(HashMap *self,
+                                     void *key,
+                                     size_t keySize,
+                                     hash_t hash,
+                                     size_t *probesAddr)
 {
+    size_t probes = 0;
     size_t mask = sHashMap__getMask(self);
     size_t maskedHash = (size_t)hash & mask;
     size_t perturb = hash;
@@ -58,6 +80,7 @@ static ssize_t sHashMap__doLookup(HashMap *self, void *key, size_t keySize, hash
     do
     {
         index = sHashMap__getIndex(self, maskedHash);
+        probes++;
 
         if (index >= 0)
         {
@@ -71,6 +94,17 @@ static ssize_t sHashMap__doLookup(HashMap *self, void *key, size_t keySize, hash
         shouldStopLoop = index == MKIX_EMPTY || (isSameKey && index >= 0);
     } while (!shouldStopLoop);
 
+    *probesAddr = probes;
+
+    return index;
+}
+
+static ssize_t sHashMap__doLookup(HashMap *self, void *key, size_t keySize, hash_t hash)
+{
+    size_t probes;
+    ssize_t index = sHashMap__probeLookup(self, key, keySize, hash, &probes);
+    HASHMAP_COUNT(self, probes, probes);
+
     return index;
 }
 
@@ -97,7 +131,7 @@ static ssize_t sHashMap__findEmptySlot(HashMap *self, hash_t hash)
 
 static void sHashMap__setIndex(HashMap *self, size_t hashPos, ssize_t index)
 {
-    assert(index > MKIX_DUMMY);
+    assert(index >= MKIX_DUMMY);
 
     if (self->log2_size < 8)
     {
@@ -123,25 +157,144 @@ static void sHashMap__keysEntryAdded(HashMap *self)
     self->usable--;
 }
 
-static ssize_t sHashMap__insertKey(HashMap *self, void *key, size_t keySize, hash_t hash)
+/* Finds the index slot pointing to the entry at `index` */
+static size_t sHashMap__lookupSlot(HashMap *self, hash_t hash, ssize_t index)
 {
-    ssize_t index = sHashMap__doLookup(self, key, keySize, hash);
+    const size_t mask = sHashMap__getMask(self);
+    size_t maskedHash = hash & mask;
 
-    if (index >= 0)
+    for (size_t perturb = hash; sHashMap__getIndex(self, maskedHash) != index;)
     {
-        return index;
+        perturb >>= PERTURB_SHIFT;
+        maskedHash = (maskedHash * 5 + perturb + 1) & mask;
     }
 
-    if (index == MKIX_EMPTY)
+    return maskedHash;
+}
+
+/* Finds the position of the first entry inserted at or after `sequence` */
+static ssize_t sHashMap__seekSequence(HashMap *self, size_t sequence)
+{
+    HashMapEntry **entries = HashMap__getEntries(self);
+    ssize_t low = 0;
+    ssize_t high = self->nentries;
+
+    while (low < high)
     {
+        ssize_t middle = low + (high - low) / 2;
+
+        if (entries[middle]->sequence < sequence)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
     }
 
-    return index;
+    return low;
+}
+
+static size_t sHashMapDigest__bucket(HashMapDigest *self, hash_t keyHash)
+{
+    return self->log2_buckets > 0 ? (size_t)(keyHash >> (64 - self->log2_buckets)) : 0;
+}
+
+static void sHashMap__digestUpdate(HashMap *self, HashMapEntry *entry, int8_t sign)
+{
+    HashMapDigest *digest = self->digest;
+
+    if (digest == NULL)
+    {
+        return;
+    }
+
+    hash_t pairHash = hashBufferWithKey(digest->k0,
+                                        digest->k1 ^ entry->digestKeyHash,
+                                        entry->value,
+                                        entry->valueSize);
+    size_t bucket = sHashMapDigest__bucket(digest, entry->digestKeyHash);
+
+    if (sign < 0)
+    {
+        digest->total -= pairHash;
+        digest->buckets[bucket] -= pairHash;
+    }
+    else
+    {
+        digest->total += pairHash;
+        digest->buckets[bucket] += pairHash;
+    }
+}
+
+/* Adds a new entry to the digest and to the list of its bucket. Buckets are
+picked by the key alone so a key lands in the same bucket on every replica
+whatever its value */
+static void sHashMap__digestLink(HashMap *self, HashMapEntry *entry)
+{
+    HashMapDigest *digest = self->digest;
+
+    if (digest == NULL)
+    {
+        return;
+    }
+
+    entry->digestKeyHash = hashBufferWithKey(digest->k0, digest->k1, entry->key, entry->keySize);
+
+    HashMapEntry **head = &digest->bucketEntries[sHashMapDigest__bucket(digest, entry->digestKeyHash)];
+    entry->digestPrev = NULL;
+    entry->digestNext = *head;
+
+    if (*head != NULL)
+    {
+        (*head)->digestPrev = entry;
+    }
+
+    *head = entry;
+    sHashMap__digestUpdate(self, entry, 1);
+}
+
+static void sHashMap__digestUnlink(HashMap *self, HashMapEntry *entry)
+{
+    HashMapDigest *digest = self->digest;
+
+    if (digest == NULL)
+    {
+        return;
+    }
+
+    sHashMap__digestUpdate(self, entry, -1);
+
+    if (entry->digestPrev != NULL)
+    {
+        entry->digestPrev->digestNext = entry->digestNext;
+    }
+    else
+    {
+        digest->bucketEntries[sHashMapDigest__bucket(digest, entry->digestKeyHash)] = entry->digestNext;
+    }
+
+    if (entry->digestNext != NULL)
+    {
+        entry->digestNext->digestPrev = entry->digestPrev;
+    }
+}
+
+static void sHashMapDigest__del(HashMapDigest *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->bucketEntries);
+    free(self);
 }
 
 static uint8_t sHashMap__getNextSize(HashMap *self)
 {
-    ssize_t minsize = self->nentries * 3;
+    ssize_t minsize = self->nitems * 3;
     uint8_t log2_size;
 
     for (log2_size = LOG2_MINSIZE;
@@ -170,23 +323,36 @@ static int8_t sHashMap__insertionResize(HashMap *self)
         return -1;
     }
 
-    assert(newHashMap->usable > self->nentries);
+    assert(newHashMap->usable > self->nitems);
     HashMapEntry **entries = HashMap__getEntries(self);
-    ssize_t index = 0;
+    HashMapEntry **newEntries = HashMap__getEntries(newHashMap);
 
-    for (int entryIndex = 0; entryIndex < self->nentries; entryIndex++)
+    // Entries are moved in insertion order, dropping the removed ones, so
+    // the `entries` array stays sorted by sequence number
+    for (ssize_t entryIndex = 0; entryIndex < self->nentries; entryIndex++)
     {
-        if (entries[entryIndex]->key != NULL && entries[entryIndex]->value != NULL)
+        HashMapEntry *entry = entries[entryIndex];
+
+        if (entry->key == NULL || entry->value == NULL)
         {
-            HashMap__setItem(newHashMap,
-                             entries[entryIndex]->key,
-                             entries[entryIndex]->keySize,
-                             entries[entryIndex]->value,
-                             entries[entryIndex]->valueSize);
+            free(entry);
+            continue;
         }
+
+        ssize_t hashPos = sHashMap__findEmptySlot(newHashMap, entry->hash);
+        sHashMap__setIndex(newHashMap, hashPos, newHashMap->nentries);
+        newEntries[newHashMap->nentries] = entry;
+        sHashMap__keysEntryAdded(newHashMap);
     }
 
-    *self = *newHashMap;
+    self->resizes++;
+
+    free(self->indices);
+    self->log2_size = newHashMap->log2_size;
+    self->log2_index_bytes = newHashMap->log2_index_bytes;
+    self->usable = newHashMap->usable;
+    self->nentries = newHashMap->nentries;
+    self->indices = newHashMap->indices;
     free(newHashMap);
 
     return 0;
@@ -215,16 +381,22 @@ HashMap *HashMap__new(uint8_t log2_size)
     }
 
     size_t indicesSize = (size_t)1 << log2_index_bytes;
-    size_t entriesSize = sizeof(HashMapEntry) * usable;
-    HashMap *hashMap = calloc(
-        1,
-        sizeof(HashMap) + indicesSize + entriesSize);
+    size_t entriesSize = sizeof(HashMapEntry *) * usable;
+    HashMap *hashMap = calloc(1, sizeof(HashMap));
 
     if (hashMap == NULL)
     {
         return NULL;
     }
 
+    hashMap->indices = calloc(1, indicesSize + entriesSize);
+
+    if (hashMap->indices == NULL)
+    {
+        free(hashMap);
+        return NULL;
+    }
+
     hashMap->usable = usable;
     hashMap->nentries = 0;
     hashMap->log2_size = log2_size;
@@ -235,29 +407,84 @@ HashMap *HashMap__new(uint8_t log2_size)
     return hashMap;
 }
 
-int8_t HashMap__setItem(HashMap *self,
-                        void *key,
-                        size_t keySize,
-                        void *value,
-                        size_t valueSize)
+/* Returns room for a value of `valueSize` bytes, inside the entry when it is
+small enough */
+static void *sHashMapEntry__allocValue(HashMapEntry *self, size_t valueSize)
 {
-    assert(key);
-    assert(value);
+    if (valueSize <= sizeof(self->inlineValue))
+    {
+        return &self->inlineValue;
+    }
+
+    void *value = malloc(valueSize);
+
+    if (value == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for hash map value");
+    }
+
+    return value;
+}
+
+static void sHashMapEntry__freeValue(HashMapEntry *self)
+{
+    if (self->value != &self->inlineValue)
+    {
+        free(self->value);
+    }
+}
+
+static int8_t sHashMapEntry__replaceValue(HashMapEntry *self,
+                                          void *value,
+                                          size_t valueSize)
+{
+    if (self->value == &self->inlineValue && valueSize <= sizeof(self->inlineValue))
+    {
+        memmove(self->value, value, valueSize);
+        self->valueSize = valueSize;
+        return CBR_SUCCESS;
+    }
 
+    void *newValue = sHashMapEntry__allocValue(self, valueSize);
+
+    if (newValue == NULL)
+    {
+        return CBR_ERROR;
+    }
+
+    memcpy(newValue, value, valueSize);
+    sHashMapEntry__freeValue(self);
+    self->value = newValue;
+    self->valueSize = valueSize;
+
+    return CBR_SUCCESS;
+}
+
+/* Appends a new entry for a key known to be absent, resizing first if needed.
+A `NULL` value leaves the value zeroed */
+static HashMapEntry *sHashMap__insertEntry(HashMap *self,
+                                          void *key,
+                                          size_t keySize,
+                                          hash_t hash,
+                                          void *value,
+                                          size_t valueSize)
+{
     if (self->usable <= 0)
     {
         if (sHashMap__insertionResize(self) < 0)
         {
-            return CBR_ERROR;
+            return NULL;
         }
     }
 
-    hash_t hash = hashBuffer(key, keySize);
-    ssize_t hashPos = sHashMap__findEmptySlot(self, hash);
-    sHashMap__setIndex(self, hashPos, self->nentries);
-    HashMapEntry **entries = HashMap__getEntries(self);
-    entries[self->nentries] = calloc(1, sizeof(HashMapEntry));
-    HashMapEntry *entry = entries[self->nentries];
+    HashMapEntry *entry = calloc(1, sizeof(HashMapEntry));
+
+    if (entry == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for hash map entry");
+        return NULL;
+    }
+
     entry->hash = hash;
 
     entry->key = calloc(1, keySize);
@@ -265,34 +492,244 @@ int8_t HashMap__setItem(HashMap *self,
     if (entry->key == NULL)
     {
         fprintf(stderr, "Failed to allocate memory for hash map key");
-        return CBR_ERROR;
+        free(entry);
+        return NULL;
     }
 
     memcpy(entry->key, key, keySize);
 
-    entry->value = calloc(1, valueSize);
+    entry->value = sHashMapEntry__allocValue(entry, valueSize);
 
     if (entry->value == NULL)
     {
-        fprintf(stderr, "Failed to allocate memory for hash map value");
-        return CBR_ERROR;
+        free(entry->key);
+        free(entry);
+        return NULL;
     }
 
-    memcpy(entry->value, value, valueSize);
+    if (value != NULL)
+    {
+        memcpy(entry->value, value, valueSize);
+    }
+    else
+    {
+        memset(entry->value, 0, valueSize);
+    }
 
     entry->keySize = keySize;
     entry->valueSize = valueSize;
+    entry->sequence = self->nextSequence++;
+
+    ssize_t hashPos = sHashMap__findEmptySlot(self, hash);
+    sHashMap__setIndex(self, hashPos, self->nentries);
+    HashMap__getEntries(self)[self->nentries] = entry;
     sHashMap__keysEntryAdded(self);
+    self->nitems++;
+    sHashMap__digestLink(self, entry);
+
+    return entry;
+}
+
+static void sHashMapEntry__clearTimer(HashMapEntry *self, HashMap *map)
+{
+    if (self->timer == NULL)
+    {
+        return;
+    }
+
+    TimingWheel__cancel(map->wheel, self->timer);
+    free(self->timer);
+    self->timer = NULL;
+}
+
+/* Removes the entry at `index` of the `entries` array. Its index slot is
+marked as dummy and the entry stays in the array, with no key, until the next
+resize */
+static void sHashMap__removeAt(HashMap *self, hash_t hash, ssize_t index)
+{
+    HashMapEntry *entry = HashMap__getEntries(self)[index];
+    sHashMap__digestUnlink(self, entry);
+    sHashMap__setIndex(self, sHashMap__lookupSlot(self, hash, index), MKIX_DUMMY);
+    sHashMapEntry__clearTimer(entry, self);
+
+    free(entry->key);
+    sHashMapEntry__freeValue(entry);
+    entry->key = NULL;
+    entry->value = NULL;
+    self->nitems--;
+}
+
+/* Whether the entry holds a key whose time to live, if any, has not run out
+before the map clock. Expired keys stay in the map until reaped */
+static uint8_t sHashMapEntry__isLive(HashMapEntry *self, HashMap *map)
+{
+    return self->key != NULL && (self->timer == NULL || self->timer->deadline > map->clock);
+}
+
+/* Same as `sHashMap__doLookup`, but expires the key on the spot if its time
+to live ran out before the map clock */
+static ssize_t sHashMap__lookupLive(HashMap *self, void *key, size_t keySize, hash_t hash)
+{
+    ssize_t index = sHashMap__doLookup(self, key, keySize, hash);
+
+    if (index >= 0)
+    {
+        TimingWheelTimer *timer = HashMap__getEntries(self)[index]->timer;
+
+        if (timer != NULL && timer->deadline <= self->clock)
+        {
+            sHashMap__removeAt(self, hash, index);
+            return MKIX_EMPTY;
+        }
+    }
+
+    return index;
+}
+
+static HashMapEntry *sHashMap__setEntry(HashMap *self,
+                                        void *key,
+                                        size_t keySize,
+                                        void *value,
+                                        size_t valueSize)
+{
+    assert(key);
+    assert(value);
+
+    hash_t hash = hashBuffer(key, keySize);
+    ssize_t index = sHashMap__lookupLive(self, key, keySize, hash);
+
+    if (index >= 0)
+    {
+        HashMapEntry *existing = HashMap__getEntries(self)[index];
+        sHashMap__digestUpdate(self, existing, -1);
+        int8_t result = sHashMapEntry__replaceValue(existing, value, valueSize);
+        sHashMap__digestUpdate(self, existing, 1);
+
+        return result == CBR_ERROR ? NULL : existing;
+    }
+
+    return sHashMap__insertEntry(self, key, keySize, hash, value, valueSize);
+}
+
+/* Sets the value of `key`, dropping any time to live it had */
+int8_t HashMap__setItem(HashMap *self,
+                        void *key,
+                        size_t keySize,
+                        void *value,
+                        size_t valueSize)
+{
+    HashMapEntry *entry = sHashMap__setEntry(self, key, keySize, value, valueSize);
+
+    if (entry == NULL)
+    {
+        return CBR_ERROR;
+    }
+
+    sHashMapEntry__clearTimer(entry, self);
 
     return CBR_SUCCESS;
 }
 
+/* Sets the value of `key` and makes it expire `ttl` ticks after the current
+map clock. Expired keys are removed when `HashMap__advanceClock` reaches their
+deadline, or earlier on lookup once the clock passed it */
+int8_t HashMap__setItemTTL(HashMap *self,
+                           void *key,
+                           size_t keySize,
+                           void *value,
+                           size_t valueSize,
+                           uint64_t ttl)
+{
+    if (self->wheel == NULL)
+    {
+        self->wheel = TimingWheel__new(self->clock);
+
+        if (self->wheel == NULL)
+        {
+            return CBR_ERROR;
+        }
+    }
+
+    // Allocated before touching the map, so a failure cannot leave the key
+    // stored without its TTL
+    TimingWheelTimer *timer = malloc(sizeof(TimingWheelTimer));
+
+    if (timer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the hash map entry timer\n");
+        return CBR_ERROR;
+    }
+
+    HashMapEntry *entry = sHashMap__setEntry(self, key, keySize, value, valueSize);
+
+    if (entry == NULL)
+    {
+        free(timer);
+        return CBR_ERROR;
+    }
+
+    if (entry->timer == NULL)
+    {
+        TimingWheelTimer__init(timer, entry);
+        entry->timer = timer;
+    }
+    else
+    {
+        free(timer);
+    }
+
+    // Saturate, a TTL running past the end of the clock never expires
+    uint64_t deadline = ttl > UINT64_MAX - self->clock ? UINT64_MAX : self->clock + ttl;
+    TimingWheel__schedule(self->wheel, entry->timer, deadline);
+
+    return CBR_SUCCESS;
+}
+
+static void sHashMap__expireTimer(TimingWheelTimer *timer, void *context)
+{
+    HashMap *self = context;
+    HashMapEntry *entry = timer->context;
+    hash_t hash = entry->hash;
+    ssize_t index = sHashMap__doLookup(self, entry->key, entry->keySize, hash);
+
+    sHashMap__removeAt(self, hash, index);
+}
+
+/* Moves the map clock to `now` and removes the keys whose time to live ran
+out, at most `maxExpired` of them, returning how many were removed. The cost
+follows the number of keys expired rather than the size of the map. Keys left
+over for lack of budget are removed by the next call or when looked up */
+size_t HashMap__advanceClock(HashMap *self, uint64_t now, size_t maxExpired)
+{
+    if (now > self->clock)
+    {
+        self->clock = now;
+    }
+
+    if (self->wheel == NULL)
+    {
+        return 0;
+    }
+
+    return TimingWheel__advance(self->wheel, now, maxExpired, sHashMap__expireTimer, self);
+}
+
 int8_t HashMap__getItem(HashMap *self,
                         void *key,
                         size_t keySize,
                         void **valueAddr)
 {
-    ssize_t index = sHashMap__doLookup(self, key, keySize, hashBuffer(key, keySize));
+    return HashMap__getItemHashed(self, key, keySize, hashBuffer(key, keySize), valueAddr);
+}
+
+/* Same as `HashMap__getItem` for a key already hashed with `hashBuffer` */
+int8_t HashMap__getItemHashed(HashMap *self,
+                              void *key,
+                              size_t keySize,
+                              hash_t hash,
+                              void **valueAddr)
+{
+    ssize_t index = sHashMap__lookupLive(self, key, keySize, hash);
 
     if (index == MKIX_EMPTY)
     {
@@ -305,17 +742,524 @@ int8_t HashMap__getItem(HashMap *self,
     return 0;
 }
 
+/* Hints the CPU to load the first index slot probed for `hash`, so a batch
+of lookups can overlap its cache misses */
+void HashMap__prefetch(HashMap *self, hash_t hash)
+{
+    size_t hashPos = (size_t)hash & sHashMap__getMask(self);
+    PREFETCH(&self->indices[hashPos << (self->log2_index_bytes - self->log2_size)]);
+}
+
+/* Inserts an absent `key` with a zeroed value of `valueSize` bytes, to be
+filled in place, and stores its entry in `entryAddr`. The entry and its value
+keep their address until the key is removed or its value set again. Not
+available with a digest, which would hash the value before it is filled */
+int8_t HashMap__reserveItem(HashMap *self,
+                            void *key,
+                            size_t keySize,
+                            size_t valueSize,
+                            HashMapEntry **entryAddr)
+{
+    if (self->digest != NULL)
+    {
+        fprintf(stderr, "Hash map values cannot be reserved with a digest enabled\n");
+        return CBR_ERROR;
+    }
+
+    hash_t hash = hashBuffer(key, keySize);
+
+    if (sHashMap__lookupLive(self, key, keySize, hash) >= 0)
+    {
+        fprintf(stderr, "Key already in hash map\n");
+        return CBR_ERROR;
+    }
+
+    HashMapEntry *entry = sHashMap__insertEntry(self, key, keySize, hash, NULL, valueSize);
+
+    if (entry == NULL)
+    {
+        return CBR_ERROR;
+    }
+
+    *entryAddr = entry;
+
+    return CBR_SUCCESS;
+}
+
+/* Removes `key` from the map */
+int8_t HashMap__delItem(HashMap *self, void *key, size_t keySize)
+{
+    hash_t hash = hashBuffer(key, keySize);
+    ssize_t index = sHashMap__lookupLive(self, key, keySize, hash);
+
+    if (index < 0)
+    {
+        fprintf(stderr, "Key not found in hash map\n");
+        return CBR_ERROR;
+    }
+
+    sHashMap__removeAt(self, hash, index);
+
+    return CBR_SUCCESS;
+}
+
+static void sMergeAddInt64(void *value, const void *delta, size_t valueSize, void *context)
+{
+    (void)valueSize;
+    (void)context;
+    *(int64_t *)value += *(const int64_t *)delta;
+}
+
+static void sMergeAddDouble(void *value, const void *delta, size_t valueSize, void *context)
+{
+    (void)valueSize;
+    (void)context;
+    *(double *)value += *(const double *)delta;
+}
+
+static int8_t sHashMap__mergeHashed(HashMap *self,
+                                    void *key,
+                                    size_t keySize,
+                                    hash_t hash,
+                                    void *delta,
+                                    size_t valueSize,
+                                    HashMapMergeFunction merge,
+                                    void *context,
+                                    void **valueAddr)
+{
+    ssize_t index = sHashMap__lookupLive(self, key, keySize, hash);
+    HashMapEntry *entry;
+
+    if (index < 0)
+    {
+        entry = sHashMap__insertEntry(self, key, keySize, hash, delta, valueSize);
+
+        if (entry == NULL)
+        {
+            return CBR_ERROR;
+        }
+    }
+    else
+    {
+        entry = HashMap__getEntries(self)[index];
+
+        if (entry->valueSize != valueSize)
+        {
+            fprintf(stderr, "Hash map value size does not match the merged value\n");
+            return CBR_ERROR;
+        }
+
+        sHashMap__digestUpdate(self, entry, -1);
+        merge(entry->value, delta, valueSize, context);
+        sHashMap__digestUpdate(self, entry, 1);
+    }
+
+    if (valueAddr != NULL)
+    {
+        *valueAddr = entry->value;
+    }
+
+    return CBR_SUCCESS;
+}
+
+static int8_t sHashMap__mergeBatch(HashMap *self,
+                                   void **keys,
+                                   const size_t *keySizes,
+                                   const void *deltas,
+                                   size_t valueSize,
+                                   size_t count,
+                                   HashMapMergeFunction merge)
+{
+    hash_t hashes[MERGE_BATCH_SIZE];
+    const char *deltaBytes = deltas;
+
+    for (size_t start = 0; start < count; start += MERGE_BATCH_SIZE)
+    {
+        size_t batchSize = count - start < MERGE_BATCH_SIZE ? count - start : MERGE_BATCH_SIZE;
+
+        // Hash the whole batch first so the index loads overlap
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            hashes[i] = hashBuffer(keys[start + i], keySizes[start + i]);
+            HashMap__prefetch(self, hashes[i]);
+        }
+
+        for (size_t i = 0; i < batchSize; i++)
+        {
+            int8_t result = sHashMap__mergeHashed(self,
+                                                  keys[start + i],
+                                                  keySizes[start + i],
+                                                  hashes[i],
+                                                  (void *)&deltaBytes[(start + i) * valueSize],
+                                                  valueSize,
+                                                  merge,
+                                                  NULL,
+                                                  NULL);
+
+            if (result == CBR_ERROR)
+            {
+                return CBR_ERROR;
+            }
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Merges `delta` into the value of `key` in place with `merge`, or stores a
+copy of `delta` when the key is absent. The key is hashed and probed once, and
+nothing is allocated when it is already present. The stored value must be
+`valueSize` bytes long. When `valueAddr` is not `NULL` it receives the address
+of the stored value */
+int8_t HashMap__mergeWith(HashMap *self,
+                          void *key,
+                          size_t keySize,
+                          void *delta,
+                          size_t valueSize,
+                          HashMapMergeFunction merge,
+                          void *context,
+                          void **valueAddr)
+{
+    return sHashMap__mergeHashed(self,
+                                 key,
+                                 keySize,
+                                 hashBuffer(key, keySize),
+                                 delta,
+                                 valueSize,
+                                 merge,
+                                 context,
+                                 valueAddr);
+}
+
+/* Adds `delta` to the `int64_t` value of `key`, absent keys counting as 0.
+The new value is stored in `resultAddr` unless it is `NULL` */
+int8_t HashMap__addInt64(HashMap *self,
+                         void *key,
+                         size_t keySize,
+                         int64_t delta,
+                         int64_t *resultAddr)
+{
+    void *value;
+    int8_t result = HashMap__mergeWith(self,
+                                       key,
+                                       keySize,
+                                       &delta,
+                                       sizeof(int64_t),
+                                       sMergeAddInt64,
+                                       NULL,
+                                       &value);
+
+    if (result == CBR_SUCCESS && resultAddr != NULL)
+    {
+        *resultAddr = *(int64_t *)value;
+    }
+
+    return result;
+}
+
+/* Adds `delta` to the `double` value of `key`, absent keys counting as 0.
+The new value is stored in `resultAddr` unless it is `NULL` */
+int8_t HashMap__addDouble(HashMap *self,
+                          void *key,
+                          size_t keySize,
+                          double delta,
+                          double *resultAddr)
+{
+    void *value;
+    int8_t result = HashMap__mergeWith(self,
+                                       key,
+                                       keySize,
+                                       &delta,
+                                       sizeof(double),
+                                       sMergeAddDouble,
+                                       NULL,
+                                       &value);
+
+    if (result == CBR_SUCCESS && resultAddr != NULL)
+    {
+        *resultAddr = *(double *)value;
+    }
+
+    return result;
+}
+
+/* Adds `deltas[i]` to the value of `keys[i]` for each of the `count` keys */
+int8_t HashMap__addInt64Batch(HashMap *self,
+                              void **keys,
+                              const size_t *keySizes,
+                              const int64_t *deltas,
+                              size_t count)
+{
+    return sHashMap__mergeBatch(self, keys, keySizes, deltas, sizeof(int64_t), count, sMergeAddInt64);
+}
+
+/* Adds `deltas[i]` to the value of `keys[i]` for each of the `count` keys */
+int8_t HashMap__addDoubleBatch(HashMap *self,
+                               void **keys,
+                               const size_t *keySizes,
+                               const double *deltas,
+                               size_t count)
+{
+    return sHashMap__mergeBatch(self, keys, keySizes, deltas, sizeof(double), count, sMergeAddDouble);
+}
+
+void HashMap__iter(HashMap *self, HashMapIterator *iterator)
+{
+    iterator->map = self;
+    iterator->resizes = self->resizes;
+    iterator->position = 0;
+    iterator->sequence = 0;
+}
+
+/* Yields the live entries in insertion order. Returns 1 while an entry was
+written to `entryAddr` and 0 once the iterator is exhausted. The iterator
+walks the `entries` array directly and only seeks back to its place after a
+resize, so it stays valid across insertions, removals and resizes */
+int8_t HashMapIterator__next(HashMapIterator *self, HashMapEntry **entryAddr)
+{
+    HashMap *map = self->map;
+
+    if (self->resizes != map->resizes)
+    {
+        self->resizes = map->resizes;
+        self->position = sHashMap__seekSequence(map, self->sequence);
+    }
+
+    HashMapEntry **entries = HashMap__getEntries(map);
+
+    while (self->position < map->nentries)
+    {
+        HashMapEntry *entry = entries[self->position++];
+
+        if (sHashMapEntry__isLive(entry, map))
+        {
+            self->sequence = entry->sequence + 1;
+            *entryAddr = entry;
+            return 1;
+        }
+    }
+
+    *entryAddr = NULL;
+    return 0;
+}
+
+/* Incremental scan in the spirit of Redis' SCAN. Copies up to `capacity`
+entry pointers starting at `cursor` into `entries` and returns the cursor to
+resume from, or 0 once the whole map was visited. Start a scan with a cursor of
+0. The cursor is an insertion sequence number rather than a position, so
+entries present during the whole scan are returned exactly once even if the
+map is written to or resized between calls */
+size_t HashMap__scan(HashMap *self,
+                     size_t cursor,
+                     HashMapEntry **entries,
+                     size_t capacity,
+                     size_t *countAddr)
+{
+    HashMapEntry **mapEntries = HashMap__getEntries(self);
+    ssize_t position = sHashMap__seekSequence(self, cursor);
+    size_t count = 0;
+
+    assert(capacity > 0);
+
+    while (position < self->nentries && count < capacity)
+    {
+        HashMapEntry *entry = mapEntries[position++];
+        cursor = entry->sequence + 1;
+
+        if (sHashMapEntry__isLive(entry, self))
+        {
+            entries[count++] = entry;
+        }
+    }
+
+    *countAddr = count;
+
+    return position < self->nentries ? cursor : 0;
+}
+
+/* Starts maintaining an order-independent digest of the (key, value) pairs.
+Each pair is hashed with SipHash under the given key, which replicas must
+share, and the hashes are summed, so two maps with the same content have the
+same digest whatever order they were built in. The sum is also kept for
+`2^log2_buckets` ranges of key hashes, so two replicas that disagree can tell
+which ranges to compare */
+int8_t HashMap__enableDigest(HashMap *self,
+                             uint64_t k0,
+                             uint64_t k1,
+                             uint8_t log2_buckets)
+{
+    if (log2_buckets > 32)
+    {
+        fprintf(stderr, "Too many digest buckets\n");
+        return CBR_ERROR;
+    }
+
+    size_t nbuckets = (size_t)1 << log2_buckets;
+    HashMapDigest *digest = calloc(1, sizeof(HashMapDigest) + sizeof(uint64_t) * nbuckets);
+
+    if (digest == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the hash map digest\n");
+        return CBR_ERROR;
+    }
+
+    digest->bucketEntries = calloc(nbuckets, sizeof(HashMapEntry *));
+
+    if (digest->bucketEntries == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the hash map digest buckets\n");
+        free(digest);
+        return CBR_ERROR;
+    }
+
+    digest->k0 = k0;
+    digest->k1 = k1;
+    digest->log2_buckets = log2_buckets;
+
+    sHashMapDigest__del(self->digest);
+    self->digest = digest;
+
+    HashMapEntry **entries = HashMap__getEntries(self);
+
+    for (ssize_t i = 0; i < self->nentries; i++)
+    {
+        if (entries[i]->key != NULL)
+        {
+            sHashMap__digestLink(self, entries[i]);
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+uint64_t HashMap__getDigest(HashMap *self)
+{
+    return self->digest == NULL ? 0 : self->digest->total;
+}
+
+/* Returns the per-range digests, borrowed from the map, and stores their
+count in `nbucketsAddr` */
+const uint64_t *HashMap__getDigestBuckets(HashMap *self, size_t *nbucketsAddr)
+{
+    if (self->digest == NULL)
+    {
+        *nbucketsAddr = 0;
+        return NULL;
+    }
+
+    *nbucketsAddr = (size_t)1 << self->digest->log2_buckets;
+
+    return self->digest->buckets;
+}
+
+/* Copies up to `capacity` pointers to the entries whose key falls in digest
+`bucket` into `entries` and returns how many matched. Used to compare only the
+ranges whose digests differ. Each bucket keeps a list of its entries, so this
+costs O(bucket size) and hashes nothing */
+size_t HashMap__getDigestBucketEntries(HashMap *self,
+                                       size_t bucket,
+                                       HashMapEntry **entries,
+                                       size_t capacity)
+{
+    HashMapDigest *digest = self->digest;
+    size_t count = 0;
+
+    if (digest == NULL || bucket >= ((size_t)1 << digest->log2_buckets))
+    {
+        return 0;
+    }
+
+    for (HashMapEntry *entry = digest->bucketEntries[bucket]; entry != NULL && count < capacity;
+         entry = entry->digestNext)
+    {
+        entries[count++] = entry;
+    }
+
+    return count;
+}
+
+/* Fills `stats` with the load and memory figures of the map. When
+`sampleStride` is not 0, every `sampleStride`-th live entry is looked up again
+to build `probeHistogram`, which makes the call O(n / sampleStride) on top of
+the O(size) walk over the indices */
+int8_t HashMap__stats(HashMap *self, HashMapStats *stats, size_t sampleStride)
+{
+    memset(stats, 0, sizeof(HashMapStats));
+
+    size_t size = (size_t)1 << self->log2_size;
+    HashMapEntry **entries = HashMap__getEntries(self);
+
+    for (size_t hashPos = 0; hashPos < size; hashPos++)
+    {
+        if (sHashMap__getIndex(self, hashPos) == MKIX_DUMMY)
+        {
+            stats->deadSlots++;
+        }
+    }
+
+    for (ssize_t i = 0; i < self->nentries; i++)
+    {
+        if (!sHashMapEntry__isLive(entries[i], self))
+        {
+            continue;
+        }
+
+        stats->nitems++;
+        stats->payloadBytes += entries[i]->keySize + entries[i]->valueSize;
+
+        if (sampleStride == 0 || (size_t)i % sampleStride != 0)
+        {
+            continue;
+        }
+
+        size_t probes;
+        sHashMap__probeLookup(self,
+                              entries[i]->key,
+                              entries[i]->keySize,
+                              entries[i]->hash,
+                              &probes);
+
+        if (probes > HASHMAP_PROBE_HISTOGRAM_SIZE)
+        {
+            probes = HASHMAP_PROBE_HISTOGRAM_SIZE;
+        }
+
+        stats->probeHistogram[probes - 1]++;
+        stats->sampledEntries++;
+    }
+
+    stats->size = size;
+    stats->loadFactor = (double)self->nentries / (double)size;
+    stats->indexBytes = (uint8_t)(1 << (self->log2_index_bytes - self->log2_size));
+    stats->indicesBytes = (size_t)1 << self->log2_index_bytes;
+    stats->entriesBytes = sizeof(HashMapEntry *) * (size_t)(self->nentries + self->usable) +
+                          sizeof(HashMapEntry) * (size_t)self->nentries;
+
+#ifdef CBR_HASHMAP_COUNTERS
+    stats->resizes = self->resizes;
+    stats->probes = self->probes;
+#endif
+
+    return CBR_SUCCESS;
+}
+
 void HashMap__del(HashMap *self)
 {
     HashMapEntry **entries = HashMap__getEntries(self);
 
-    for (size_t i = 0; i < self->nentries; i++)
+    for (ssize_t i = 0; i < self->nentries; i++)
     {
         if (entries[i] != NULL)
         {
+            free(entries[i]->timer);
+            free(entries[i]->key);
+            sHashMapEntry__freeValue(entries[i]);
             free(entries[i]);
         }
     }
 
+    TimingWheel__del(self->wheel);
+    sHashMapDigest__del(self->digest);
+    free(self->indices);
     free(self);
 }
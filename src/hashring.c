@@ -0,0 +1,222 @@
+#include <endian.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/_hash.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/hashring.h>
+
+static int sHashRingPoint__compare(const void *left, const void *right)
+{
+    const HashRingPoint *a = left;
+    const HashRingPoint *b = right;
+
+    if (a->hash != b->hash)
+    {
+        return a->hash < b->hash ? -1 : 1;
+    }
+
+    // Equal hashes are ordered by node so every ring resolves them alike
+    return a->nodeId < b->nodeId ? -1 : a->nodeId > b->nodeId;
+}
+
+/* Returns the first point at or after `hash`, wrapping around the ring */
+static uint32_t sHashRing__lookup(HashRing *self, hash_t hash)
+{
+    size_t low = 0;
+    size_t high = self->numberOfPoints;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (self->points[middle].hash < hash)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return self->points[low == self->numberOfPoints ? 0 : low].nodeId;
+}
+
+/* Creates an empty ring. Each node gets `virtualNodes` points per unit of
+weight, more points spreading keys more evenly at the cost of memory.
+`k0` and `k1` key the hash of points and keys */
+HashRing *HashRing__new(uint32_t virtualNodes, uint64_t k0, uint64_t k1)
+{
+    if (virtualNodes == 0)
+    {
+        fprintf(stderr, "Hash ring needs at least one virtual node per weight\n");
+        return NULL;
+    }
+
+    HashRing *ring = calloc(1, sizeof(HashRing));
+
+    if (ring == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the hash ring\n");
+        return NULL;
+    }
+
+    ring->k0 = k0;
+    ring->k1 = k1;
+    ring->virtualNodes = virtualNodes;
+
+    return ring;
+}
+
+/* Places `weight` times `virtualNodes` points for `nodeId`. Only the keys
+falling right before the new points move to the node */
+int8_t HashRing__addNode(HashRing *self, uint32_t nodeId, uint32_t weight)
+{
+    size_t added = (size_t)weight * self->virtualNodes;
+
+    if (weight == 0)
+    {
+        fprintf(stderr, "Hash ring node weight must be positive\n");
+        return CBR_ERROR;
+    }
+
+    for (size_t i = 0; i < self->numberOfPoints; i++)
+    {
+        if (self->points[i].nodeId == nodeId)
+        {
+            fprintf(stderr, "Node is already on the hash ring\n");
+            return CBR_ERROR;
+        }
+    }
+
+    if (self->numberOfPoints + added > self->capacity)
+    {
+        size_t capacity = self->capacity == 0 ? 64 : self->capacity;
+
+        while (capacity < self->numberOfPoints + added)
+        {
+            capacity *= 2;
+        }
+
+        HashRingPoint *points = realloc(self->points, sizeof(HashRingPoint) * capacity);
+
+        if (points == NULL)
+        {
+            fprintf(stderr, "Failed to allocate memory for the hash ring points\n");
+            return CBR_ERROR;
+        }
+
+        self->points = points;
+        self->capacity = capacity;
+    }
+
+    for (uint64_t replica = 0; replica < added; replica++)
+    {
+        // Little-endian so hosts of either byte order place the node alike
+        uint64_t seed[2] = {htole64(nodeId), htole64(replica)};
+        HashRingPoint *point = &self->points[self->numberOfPoints++];
+
+        point->hash = hashBufferWithKey(self->k0, self->k1, seed, sizeof(seed));
+        point->nodeId = nodeId;
+    }
+
+    qsort(self->points, self->numberOfPoints, sizeof(HashRingPoint), sHashRingPoint__compare);
+
+    return CBR_SUCCESS;
+}
+
+/* Removes the points of `nodeId`, whose keys go to the next point on the
+ring while every other key stays in place */
+int8_t HashRing__removeNode(HashRing *self, uint32_t nodeId)
+{
+    size_t kept = 0;
+
+    for (size_t i = 0; i < self->numberOfPoints; i++)
+    {
+        if (self->points[i].nodeId != nodeId)
+        {
+            self->points[kept++] = self->points[i];
+        }
+    }
+
+    if (kept == self->numberOfPoints)
+    {
+        fprintf(stderr, "Node is not on the hash ring\n");
+        return CBR_ERROR;
+    }
+
+    self->numberOfPoints = kept;
+
+    return CBR_SUCCESS;
+}
+
+int8_t HashRing__getNode(HashRing *self, const void *key, size_t keySize, uint32_t *nodeAddr)
+{
+    return HashRing__getNodeHashed(self, hashBufferWithKey(self->k0, self->k1, key, keySize), nodeAddr);
+}
+
+int8_t HashRing__getNodeHashed(HashRing *self, hash_t hash, uint32_t *nodeAddr)
+{
+    if (self->numberOfPoints == 0)
+    {
+        fprintf(stderr, "Hash ring is empty\n");
+        return CBR_ERROR;
+    }
+
+    *nodeAddr = sHashRing__lookup(self, hash);
+
+    return CBR_SUCCESS;
+}
+
+/* Stores in `nodes` the node of each of the `count` keys */
+int8_t HashRing__getNodeBatch(HashRing *self,
+                              void **keys,
+                              const size_t *keySizes,
+                              size_t count,
+                              uint32_t *nodes)
+{
+    if (self->numberOfPoints == 0)
+    {
+        fprintf(stderr, "Hash ring is empty\n");
+        return CBR_ERROR;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        nodes[i] = sHashRing__lookup(self, hashBufferWithKey(self->k0, self->k1, keys[i], keySizes[i]));
+    }
+
+    return CBR_SUCCESS;
+}
+
+void HashRing__del(HashRing *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->points);
+    free(self);
+}
+
+/* Lamping and Veach's jump consistent hash: maps `key` to a bucket in
+[0, numberOfBuckets) with no memory, moving only 1/n of the keys when a
+bucket is appended. Buckets can only be added or removed at the end, so it
+suits numbered shards rather than named nodes. Returns -1 without buckets */
+int32_t jumpConsistentHash(uint64_t key, int32_t numberOfBuckets)
+{
+    int64_t bucket = -1;
+    int64_t next = 0;
+
+    while (next < numberOfBuckets)
+    {
+        bucket = next;
+        key = key * 2862933555777941757ULL + 1;
+        next = (int64_t)((double)(bucket + 1) * ((double)(1LL << 31) / (double)((key >> 33) + 1)));
+    }
+
+    return (int32_t)bucket;
+}
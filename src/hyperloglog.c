@@ -0,0 +1,187 @@
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/_hash.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/hyperloglog.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define REGISTER_ALIGNMENT 16
+
+static size_t sHyperLogLog__numberOfRegisters(const HyperLogLog *self)
+{
+    return (size_t)1 << self->precision;
+}
+
+static uint8_t sLeadingZeros(uint64_t value)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_clzll(value);
+#else
+    uint8_t count = 0;
+
+    for (uint64_t bit = (uint64_t)1 << 63; !(value & bit); bit >>= 1)
+    {
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+/* `precision` ranges from `HYPERLOGLOG_MIN_PRECISION` to
+`HYPERLOGLOG_MAX_PRECISION`, 14 giving 16 KiB and 0.8% error. `k0` and `k1`
+key the SipHash of `HyperLogLog__add` and must match between sketches that
+are merged, on any host */
+HyperLogLog *HyperLogLog__new(uint8_t precision, uint64_t k0, uint64_t k1)
+{
+    if (precision < HYPERLOGLOG_MIN_PRECISION || precision > HYPERLOGLOG_MAX_PRECISION)
+    {
+        fprintf(stderr, "HyperLogLog precision out of range\n");
+        return NULL;
+    }
+
+    HyperLogLog *hll = malloc(sizeof(HyperLogLog));
+
+    if (hll == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the HyperLogLog\n");
+        return NULL;
+    }
+
+    hll->k0 = k0;
+    hll->k1 = k1;
+    hll->precision = precision;
+    hll->registers = aligned_alloc(REGISTER_ALIGNMENT, sHyperLogLog__numberOfRegisters(hll));
+
+    if (hll->registers == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the HyperLogLog registers\n");
+        free(hll);
+        return NULL;
+    }
+
+    memset(hll->registers, 0, sHyperLogLog__numberOfRegisters(hll));
+
+    return hll;
+}
+
+int8_t HyperLogLog__add(HyperLogLog *self, const void *key, size_t keySize)
+{
+    return HyperLogLog__addHashed(self, hashBufferWithKey(self->k0, self->k1, key, keySize));
+}
+
+/* The top `precision` bits of the hash pick the register and the rank is the
+position of the first set bit in the rest */
+int8_t HyperLogLog__addHashed(HyperLogLog *self, hash_t hash)
+{
+    size_t index = (size_t)(hash >> (64 - self->precision));
+    // The guard bit bounds the rank when the remaining bits are all zero
+    uint64_t remaining = (hash << self->precision) | ((uint64_t)1 << (self->precision - 1));
+    uint8_t rank = sLeadingZeros(remaining) + 1;
+
+    if (rank > self->registers[index])
+    {
+        self->registers[index] = rank;
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Folds `other` into `self` with a per-register maximum, 16 registers at a
+time with SSE2. The union of the two key sets is then estimated */
+int8_t HyperLogLog__merge(HyperLogLog *self, const HyperLogLog *other)
+{
+    if (self->precision != other->precision || self->k0 != other->k0 || self->k1 != other->k1)
+    {
+        fprintf(stderr, "HyperLogLog sketches have different parameters\n");
+        return CBR_ERROR;
+    }
+
+    // With a precision of at least 4 the registers fill whole vectors
+    size_t bytes = sHyperLogLog__numberOfRegisters(self);
+
+#if defined(__SSE2__)
+    for (size_t i = 0; i < bytes; i += 16)
+    {
+        __m128i mine = _mm_load_si128((const __m128i *)(self->registers + i));
+        __m128i theirs = _mm_load_si128((const __m128i *)(other->registers + i));
+        _mm_store_si128((__m128i *)(self->registers + i), _mm_max_epu8(mine, theirs));
+    }
+#else
+    for (size_t i = 0; i < bytes; i++)
+    {
+        if (other->registers[i] > self->registers[i])
+        {
+            self->registers[i] = other->registers[i];
+        }
+    }
+#endif
+
+    return CBR_SUCCESS;
+}
+
+/* Raw harmonic-mean estimate, falling back to linear counting over the empty
+registers while it is below 2.5 times their number */
+double HyperLogLog__estimate(const HyperLogLog *self)
+{
+    size_t numberOfRegisters = sHyperLogLog__numberOfRegisters(self);
+    size_t zeros = 0;
+    double sum = 0.0;
+
+#if defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128();
+
+    for (size_t i = 0; i < numberOfRegisters; i += 16)
+    {
+        __m128i registers = _mm_load_si128((const __m128i *)(self->registers + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(registers, zero));
+#if defined(__GNUC__)
+        zeros += (size_t)__builtin_popcount(mask);
+#else
+        for (; mask != 0; mask &= mask - 1)
+        {
+            zeros++;
+        }
+#endif
+    }
+#endif
+
+    for (size_t i = 0; i < numberOfRegisters; i++)
+    {
+        sum += ldexp(1.0, -self->registers[i]);
+#if !defined(__SSE2__)
+        zeros += self->registers[i] == 0;
+#endif
+    }
+
+    double m = (double)numberOfRegisters;
+    double alpha = numberOfRegisters == 16   ? 0.673
+                   : numberOfRegisters == 32 ? 0.697
+                   : numberOfRegisters == 64 ? 0.709
+                                             : 0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+
+    if (estimate <= 2.5 * m && zeros != 0)
+    {
+        return m * log(m / (double)zeros);
+    }
+
+    return estimate;
+}
+
+void HyperLogLog__del(HyperLogLog *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->registers);
+    free(self);
+}
@@ -0,0 +1,255 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/lockfreestack.h>
+
+#define NIL 0
+#define PACK(tag, index) (((uint64_t)(tag) << 32) | (uint64_t)(index))
+#define INDEX(head) ((uint32_t)(head))
+#define TAG(head) ((uint32_t)((head) >> 32))
+
+#define POP_EMPTY 0
+#define POP_TAKEN 1
+#define POP_CONTENDED 2
+
+static _Thread_local uint32_t sRandomState;
+
+/* Per-thread xorshift spreading threads over the elimination slots */
+static uint32_t sRandom(void)
+{
+    if (sRandomState == 0)
+    {
+        sRandomState = (uint32_t)(uintptr_t)&sRandomState | 1;
+    }
+
+    sRandomState ^= sRandomState << 13;
+    sRandomState ^= sRandomState >> 17;
+    sRandomState ^= sRandomState << 5;
+
+    return sRandomState;
+}
+
+static char *sLockFreeStack__value(LockFreeStack *self, uint32_t index)
+{
+    return self->values + (size_t)(index - 1) * self->elementSize;
+}
+
+/* Single compare-and-swap attempt at pushing node `index` on `list` */
+static uint8_t sLockFreeStack__tryPush(LockFreeStack *self, _Atomic uint64_t *list, uint32_t index)
+{
+    uint64_t head = atomic_load_explicit(list, memory_order_relaxed);
+
+    atomic_store_explicit(&self->next[index - 1], INDEX(head), memory_order_relaxed);
+
+    return atomic_compare_exchange_strong_explicit(list,
+                                                   &head,
+                                                   PACK(TAG(head) + 1, index),
+                                                   memory_order_release,
+                                                   memory_order_relaxed);
+}
+
+/* Single compare-and-swap attempt at popping `list`. The next index may be
+read from a node another thread already reused, in which case the tag has
+moved and the swap fails */
+static uint8_t sLockFreeStack__tryPop(LockFreeStack *self, _Atomic uint64_t *list, uint32_t *indexAddr)
+{
+    uint64_t head = atomic_load_explicit(list, memory_order_acquire);
+
+    if (INDEX(head) == NIL)
+    {
+        return POP_EMPTY;
+    }
+
+    uint32_t next = atomic_load_explicit(&self->next[INDEX(head) - 1], memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(list,
+                                                 &head,
+                                                 PACK(TAG(head) + 1, next),
+                                                 memory_order_acquire,
+                                                 memory_order_relaxed))
+    {
+        return POP_CONTENDED;
+    }
+
+    *indexAddr = INDEX(head);
+
+    return POP_TAKEN;
+}
+
+static uint32_t sLockFreeStack__popFree(LockFreeStack *self)
+{
+    uint32_t index = NIL;
+
+    while (sLockFreeStack__tryPop(self, &self->free, &index) == POP_CONTENDED)
+    {
+    }
+
+    return index;
+}
+
+static void sLockFreeStack__pushFree(LockFreeStack *self, uint32_t index)
+{
+    while (!sLockFreeStack__tryPush(self, &self->free, index))
+    {
+    }
+}
+
+/* Offers node `index` in a random elimination slot for a while. Returns 1
+when a concurrent pop took it, 0 when the offer was withdrawn */
+static uint8_t sLockFreeStack__eliminatePush(LockFreeStack *self, uint32_t index)
+{
+    _Atomic uint64_t *slot = &self->elimination[sRandom() % LOCK_FREE_STACK_ELIMINATION_SLOTS];
+    // The ticket tells this offer apart from a later one of the same node
+    uint64_t offer = PACK(atomic_fetch_add_explicit(&self->tickets, 1, memory_order_relaxed), index);
+    uint64_t expected = 0;
+
+    if (!atomic_compare_exchange_strong_explicit(slot, &expected, offer, memory_order_release, memory_order_relaxed))
+    {
+        return 0;
+    }
+
+    for (int spin = 0; spin < LOCK_FREE_STACK_ELIMINATION_SPINS; spin++)
+    {
+        if (atomic_load_explicit(slot, memory_order_relaxed) != offer)
+        {
+            return 1;
+        }
+    }
+
+    expected = offer;
+
+    return !atomic_compare_exchange_strong_explicit(slot, &expected, 0, memory_order_relaxed, memory_order_relaxed);
+}
+
+/* Takes a push offer from a random elimination slot, if there is one */
+static uint32_t sLockFreeStack__eliminatePop(LockFreeStack *self)
+{
+    _Atomic uint64_t *slot = &self->elimination[sRandom() % LOCK_FREE_STACK_ELIMINATION_SLOTS];
+    uint64_t offer = atomic_load_explicit(slot, memory_order_acquire);
+
+    if (offer != 0 &&
+        atomic_compare_exchange_strong_explicit(slot, &offer, 0, memory_order_acquire, memory_order_relaxed))
+    {
+        return INDEX(offer);
+    }
+
+    return NIL;
+}
+
+/* Creates a stack holding up to `capacity` elements of `elementSize` bytes,
+all of its memory being allocated here */
+LockFreeStack *LockFreeStack__new(size_t elementSize, uint32_t capacity)
+{
+    if (capacity == 0 || capacity == UINT32_MAX || elementSize == 0)
+    {
+        fprintf(stderr, "Invalid lock-free stack capacity or element size\n");
+        return NULL;
+    }
+
+    LockFreeStack *stack = malloc(sizeof(LockFreeStack));
+
+    if (stack == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the lock-free stack\n");
+        return NULL;
+    }
+
+    stack->next = malloc(sizeof(_Atomic uint32_t) * capacity);
+    stack->values = malloc(elementSize * capacity);
+
+    if (stack->next == NULL || stack->values == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the lock-free stack nodes\n");
+        free(stack->next);
+        free(stack->values);
+        free(stack);
+        return NULL;
+    }
+
+    stack->elementSize = elementSize;
+    stack->capacity = capacity;
+    atomic_init(&stack->top, PACK(0, NIL));
+    atomic_init(&stack->free, PACK(0, 1));
+    atomic_init(&stack->tickets, 0);
+
+    for (uint32_t index = 1; index <= capacity; index++)
+    {
+        atomic_init(&stack->next[index - 1], index < capacity ? index + 1 : NIL);
+    }
+
+    for (int i = 0; i < LOCK_FREE_STACK_ELIMINATION_SLOTS; i++)
+    {
+        atomic_init(&stack->elimination[i], 0);
+    }
+
+    return stack;
+}
+
+/* Copies `value` onto the stack. When the compare-and-swap on the top
+fails, the push is offered to a concurrent pop through the elimination
+array before retrying. Returns CBR_ERROR, without printing, when all the
+nodes are in use */
+int8_t LockFreeStack__push(LockFreeStack *self, const void *value)
+{
+    uint32_t index = sLockFreeStack__popFree(self);
+
+    if (index == NIL)
+    {
+        return CBR_ERROR;
+    }
+
+    memcpy(sLockFreeStack__value(self, index), value, self->elementSize);
+
+    while (!sLockFreeStack__tryPush(self, &self->top, index))
+    {
+        if (sLockFreeStack__eliminatePush(self, index))
+        {
+            break;
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Copies the top element into `buffer` and removes it. Returns CBR_ERROR,
+without printing as consumers usually poll, when the stack is empty */
+int8_t LockFreeStack__pop(LockFreeStack *self, void *buffer)
+{
+    uint32_t index = NIL;
+
+    while (sLockFreeStack__tryPop(self, &self->top, &index) == POP_CONTENDED)
+    {
+        index = sLockFreeStack__eliminatePop(self);
+
+        if (index != NIL)
+        {
+            break;
+        }
+    }
+
+    if (index == NIL)
+    {
+        return CBR_ERROR;
+    }
+
+    memcpy(buffer, sLockFreeStack__value(self, index), self->elementSize);
+    sLockFreeStack__pushFree(self, index);
+
+    return CBR_SUCCESS;
+}
+
+/* Frees the stack, which must no longer be used by any thread */
+void LockFreeStack__del(LockFreeStack *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->next);
+    free(self->values);
+    free(self);
+}
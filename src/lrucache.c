@@ -0,0 +1,338 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/hashmap.h>
+#include <cbarroso/lrucache.h>
+
+#define MIN_NODES_CAPACITY 16
+
+LruCache *LruCache__new(size_t maxBytes,
+                        uint8_t mode,
+                        LruCacheEvictFunction onEvict,
+                        void *evictContext)
+{
+    LruCache *cache = calloc(1, sizeof(LruCache));
+
+    if (cache == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the LRU cache\n");
+        return NULL;
+    }
+
+    cache->index = HashMap__new(LOG2_MINSIZE);
+
+    if (cache->index == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the LRU cache index\n");
+        free(cache);
+        return NULL;
+    }
+
+    cache->maxBytes = maxBytes;
+    cache->mode = mode;
+    cache->randomState = 0x9E3779B97F4A7C15ULL;
+    cache->onEvict = onEvict;
+    cache->evictContext = evictContext;
+
+    return cache;
+}
+
+static uint64_t sLruCache__random(LruCache *self)
+{
+    uint64_t x = self->randomState;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    self->randomState = x;
+
+    return x;
+}
+
+static void sLruCache__unlink(LruCache *self, LruCacheNode *node)
+{
+    if (node->prev != NULL)
+    {
+        node->prev->next = node->next;
+    }
+    else
+    {
+        self->head = node->next;
+    }
+
+    if (node->next != NULL)
+    {
+        node->next->prev = node->prev;
+    }
+    else
+    {
+        self->tail = node->prev;
+    }
+
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+static void sLruCache__pushFront(LruCache *self, LruCacheNode *node)
+{
+    node->prev = NULL;
+    node->next = self->head;
+
+    if (self->head != NULL)
+    {
+        self->head->prev = node;
+    }
+    else
+    {
+        self->tail = node;
+    }
+
+    self->head = node;
+}
+
+static int8_t sLruCache__track(LruCache *self, LruCacheNode *node)
+{
+    if (self->mode == LRU_CACHE_MODE_EXACT)
+    {
+        sLruCache__pushFront(self, node);
+        return CBR_SUCCESS;
+    }
+
+    if (self->numberOfNodes == self->nodesCapacity)
+    {
+        size_t newCapacity = self->nodesCapacity > 0 ? self->nodesCapacity * 2 : MIN_NODES_CAPACITY;
+        LruCacheNode **newNodes = realloc(self->nodes, sizeof(LruCacheNode *) * newCapacity);
+
+        if (newNodes == NULL)
+        {
+            fprintf(stderr, "Failed to allocate memory for the LRU cache nodes\n");
+            return CBR_ERROR;
+        }
+
+        self->nodes = newNodes;
+        self->nodesCapacity = newCapacity;
+    }
+
+    node->position = self->numberOfNodes;
+    self->nodes[self->numberOfNodes++] = node;
+
+    return CBR_SUCCESS;
+}
+
+static void sLruCache__untrack(LruCache *self, LruCacheNode *node)
+{
+    if (self->mode == LRU_CACHE_MODE_EXACT)
+    {
+        sLruCache__unlink(self, node);
+        return;
+    }
+
+    LruCacheNode *last = self->nodes[--self->numberOfNodes];
+    self->nodes[node->position] = last;
+    last->position = node->position;
+}
+
+static size_t sLruCacheNode__valueSize(LruCacheNode *self)
+{
+    return self->entry->valueSize - sizeof(LruCacheNode);
+}
+
+/* Removes a node from the recency tracking and the index, which frees it */
+static void sLruCache__release(LruCache *self, LruCacheNode *node)
+{
+    HashMapEntry *entry = node->entry;
+
+    sLruCache__untrack(self, node);
+    self->usedBytes -= entry->keySize + sLruCacheNode__valueSize(node);
+    HashMap__delItem(self->index, entry->key, entry->keySize);
+}
+
+/* Samples the nodes for the least recently used one, never picking
+`exclude` */
+static LruCacheNode *sLruCache__pickVictim(LruCache *self, LruCacheNode *exclude)
+{
+    if (self->mode == LRU_CACHE_MODE_EXACT)
+    {
+        return self->tail != exclude ? self->tail : NULL;
+    }
+
+    if (self->numberOfNodes < 2)
+    {
+        return NULL;
+    }
+
+    LruCacheNode *victim = NULL;
+
+    for (int i = 0; i < LRU_CACHE_SAMPLES; i++)
+    {
+        size_t position = sLruCache__random(self) % self->numberOfNodes;
+        LruCacheNode *candidate = self->nodes[position];
+
+        if (candidate == exclude)
+        {
+            candidate = self->nodes[(position + 1) % self->numberOfNodes];
+        }
+
+        if (victim == NULL || candidate->lastAccess < victim->lastAccess)
+        {
+            victim = candidate;
+        }
+    }
+
+    return victim;
+}
+
+static int8_t sLruCache__evict(LruCache *self, LruCacheNode *exclude)
+{
+    LruCacheNode *victim = sLruCache__pickVictim(self, exclude);
+
+    if (victim == NULL)
+    {
+        return CBR_ERROR;
+    }
+
+    if (self->onEvict != NULL)
+    {
+        self->onEvict(victim->entry->key,
+                      victim->entry->keySize,
+                      victim->value,
+                      sLruCacheNode__valueSize(victim),
+                      self->evictContext);
+    }
+
+    sLruCache__release(self, victim);
+
+    return CBR_SUCCESS;
+}
+
+/* Inserts or replaces `key`, evicting the least recently used items until
+the cache fits in its byte budget. Replaced values are not passed to the
+eviction callback */
+int8_t LruCache__put(LruCache *self,
+                     void *key,
+                     size_t keySize,
+                     void *value,
+                     size_t valueSize)
+{
+    size_t itemBytes = keySize + valueSize;
+
+    if (itemBytes > self->maxBytes)
+    {
+        fprintf(stderr, "Item does not fit in the LRU cache\n");
+        return CBR_ERROR;
+    }
+
+    void *nodeAddr = NULL;
+    HashMap__getItem(self->index, key, keySize, &nodeAddr);
+    LruCacheNode *node = nodeAddr;
+
+    if (node != NULL && sLruCacheNode__valueSize(node) == valueSize)
+    {
+        // Same size, so the value is overwritten without touching the index
+        memcpy(node->value, value, valueSize);
+        node->lastAccess = ++self->clock;
+
+        if (self->mode == LRU_CACHE_MODE_EXACT && self->head != node)
+        {
+            sLruCache__unlink(self, node);
+            sLruCache__pushFront(self, node);
+        }
+
+        return CBR_SUCCESS;
+    }
+
+    if (node != NULL)
+    {
+        sLruCache__release(self, node);
+    }
+
+    HashMapEntry *entry;
+
+    if (HashMap__reserveItem(self->index, key, keySize, sizeof(LruCacheNode) + valueSize, &entry) == CBR_ERROR)
+    {
+        return CBR_ERROR;
+    }
+
+    node = entry->value;
+    node->entry = entry;
+    node->lastAccess = ++self->clock;
+    memcpy(node->value, value, valueSize);
+
+    if (sLruCache__track(self, node) == CBR_ERROR)
+    {
+        HashMap__delItem(self->index, key, keySize);
+        return CBR_ERROR;
+    }
+
+    self->usedBytes += itemBytes;
+
+    while (self->usedBytes > self->maxBytes)
+    {
+        if (sLruCache__evict(self, node) == CBR_ERROR)
+        {
+            return CBR_ERROR;
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Looks up `key` and marks it as recently used. The value is borrowed from
+the cache and stays valid until the next `put` or `remove`; `NULL` is stored
+for absent keys */
+int8_t LruCache__get(LruCache *self,
+                     void *key,
+                     size_t keySize,
+                     void **valueAddr)
+{
+    void *nodeAddr = NULL;
+    HashMap__getItem(self->index, key, keySize, &nodeAddr);
+
+    if (nodeAddr == NULL)
+    {
+        *valueAddr = NULL;
+        return CBR_SUCCESS;
+    }
+
+    LruCacheNode *node = nodeAddr;
+    node->lastAccess = ++self->clock;
+
+    if (self->mode == LRU_CACHE_MODE_EXACT && self->head != node)
+    {
+        sLruCache__unlink(self, node);
+        sLruCache__pushFront(self, node);
+    }
+
+    *valueAddr = node->value;
+
+    return CBR_SUCCESS;
+}
+
+int8_t LruCache__remove(LruCache *self, void *key, size_t keySize)
+{
+    void *nodeAddr = NULL;
+    HashMap__getItem(self->index, key, keySize, &nodeAddr);
+
+    if (nodeAddr == NULL)
+    {
+        fprintf(stderr, "Key not found in LRU cache\n");
+        return CBR_ERROR;
+    }
+
+    sLruCache__release(self, nodeAddr);
+
+    return CBR_SUCCESS;
+}
+
+void LruCache__del(LruCache *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    HashMap__del(self->index);
+    free(self->nodes);
+    free(self);
+}
@@ -0,0 +1,207 @@
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/mpmcqueue.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#else
+#define CPU_RELAX() ((void)0)
+#endif
+
+/* A cell is its sequence number followed by the element */
+static _Atomic size_t *sMpmcQueue__sequence(MpmcQueue *self, size_t position)
+{
+    return (_Atomic size_t *)(self->cells + (position & (self->capacity - 1)) * self->cellSize);
+}
+
+static char *sMpmcQueue__value(MpmcQueue *self, size_t position)
+{
+    return (char *)sMpmcQueue__sequence(self, position) + sizeof(_Atomic size_t);
+}
+
+/* Creates a queue holding up to `capacity` elements, rounded up to a power
+of two, of `elementSize` bytes */
+MpmcQueue *MpmcQueue__new(size_t elementSize, size_t capacity)
+{
+    if (elementSize == 0 || capacity < 2)
+    {
+        fprintf(stderr, "MPMC queue needs a positive element size and a capacity of at least 2\n");
+        return NULL;
+    }
+
+    // Round cells up so every sequence number stays aligned
+    size_t cellSize = sizeof(_Atomic size_t) +
+                      (elementSize + sizeof(_Atomic size_t) - 1) / sizeof(_Atomic size_t) * sizeof(_Atomic size_t);
+
+    if (elementSize > SIZE_MAX / 2 || capacity > ((SIZE_MAX >> 1) + 1) / cellSize)
+    {
+        fprintf(stderr, "MPMC queue capacity is too large\n");
+        return NULL;
+    }
+
+    MpmcQueue *queue = aligned_alloc(MPMC_QUEUE_CACHE_LINE, sizeof(MpmcQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the MPMC queue\n");
+        return NULL;
+    }
+
+    queue->capacity = 2;
+
+    while (queue->capacity < capacity)
+    {
+        queue->capacity *= 2;
+    }
+
+    queue->cellSize = cellSize;
+    queue->elementSize = elementSize;
+    queue->cells = malloc(queue->capacity * queue->cellSize);
+
+    if (queue->cells == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the MPMC queue cells\n");
+        free(queue);
+        return NULL;
+    }
+
+    for (size_t position = 0; position < queue->capacity; position++)
+    {
+        atomic_init(sMpmcQueue__sequence(queue, position), position);
+    }
+
+    atomic_init(&queue->enqueuePosition, 0);
+    atomic_init(&queue->dequeuePosition, 0);
+
+    return queue;
+}
+
+/* Claims the enqueue position whose cell sequence equals it, copies the
+element and hands the cell to consumers by setting its sequence one past.
+Returns CBR_ERROR, without printing, when the queue is full */
+int8_t MpmcQueue__tryEnqueue(MpmcQueue *self, const void *value)
+{
+    size_t position = atomic_load_explicit(&self->enqueuePosition, memory_order_relaxed);
+
+    for (;;)
+    {
+        _Atomic size_t *sequence = sMpmcQueue__sequence(self, position);
+        intptr_t difference = (intptr_t)atomic_load_explicit(sequence, memory_order_acquire) - (intptr_t)position;
+
+        if (difference == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&self->enqueuePosition,
+                                                      &position,
+                                                      position + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed))
+            {
+                memcpy(sMpmcQueue__value(self, position), value, self->elementSize);
+                atomic_store_explicit(sequence, position + 1, memory_order_release);
+
+                return CBR_SUCCESS;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The cell still holds the element from one lap ago
+            return CBR_ERROR;
+        }
+        else
+        {
+            position = atomic_load_explicit(&self->enqueuePosition, memory_order_relaxed);
+        }
+    }
+}
+
+/* Claims the dequeue position whose cell sequence is one past it, copies
+the element out and frees the cell for the producer of the next lap.
+Returns CBR_ERROR, without printing, when the queue is empty */
+int8_t MpmcQueue__tryDequeue(MpmcQueue *self, void *buffer)
+{
+    size_t position = atomic_load_explicit(&self->dequeuePosition, memory_order_relaxed);
+
+    for (;;)
+    {
+        _Atomic size_t *sequence = sMpmcQueue__sequence(self, position);
+        intptr_t difference = (intptr_t)atomic_load_explicit(sequence, memory_order_acquire) - (intptr_t)(position + 1);
+
+        if (difference == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&self->dequeuePosition,
+                                                      &position,
+                                                      position + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed))
+            {
+                memcpy(buffer, sMpmcQueue__value(self, position), self->elementSize);
+                atomic_store_explicit(sequence, position + self->capacity, memory_order_release);
+
+                return CBR_SUCCESS;
+            }
+        }
+        else if (difference < 0)
+        {
+            return CBR_ERROR;
+        }
+        else
+        {
+            position = atomic_load_explicit(&self->dequeuePosition, memory_order_relaxed);
+        }
+    }
+}
+
+/* Enqueues `value`, spinning while the queue is full and then yielding
+the CPU between attempts */
+int8_t MpmcQueue__enqueue(MpmcQueue *self, const void *value)
+{
+    for (unsigned int attempt = 0; MpmcQueue__tryEnqueue(self, value) == CBR_ERROR; attempt++)
+    {
+        if (attempt < MPMC_QUEUE_SPINS)
+        {
+            CPU_RELAX();
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Dequeues into `buffer`, spinning while the queue is empty and then
+yielding the CPU between attempts */
+int8_t MpmcQueue__dequeue(MpmcQueue *self, void *buffer)
+{
+    for (unsigned int attempt = 0; MpmcQueue__tryDequeue(self, buffer) == CBR_ERROR; attempt++)
+    {
+        if (attempt < MPMC_QUEUE_SPINS)
+        {
+            CPU_RELAX();
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Frees the queue, which no thread may still be using */
+void MpmcQueue__del(MpmcQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->cells);
+    free(self);
+}
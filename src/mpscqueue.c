@@ -0,0 +1,123 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/mpscqueue.h>
+
+MpscQueue *MpscQueue__new(void)
+{
+    MpscQueue *queue = aligned_alloc(MPSC_QUEUE_CACHE_LINE, sizeof(MpscQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the MPSC queue\n");
+        return NULL;
+    }
+
+    MpscQueueNode__init(&queue->stub, NULL, 0);
+    atomic_init(&queue->head, &queue->stub);
+    queue->tail = &queue->stub;
+
+    return queue;
+}
+
+void MpscQueueNode__init(MpscQueueNode *self, void *value, size_t valueSize)
+{
+    self->value = value;
+    self->valueSize = valueSize;
+    atomic_init(&self->next, NULL);
+}
+
+/* Wait-free: one exchange on `head` then linking the previous head to the
+node. Until that link is stored the consumer sees the queue end before the
+node, which it treats as empty */
+int8_t MpscQueue__enqueue(MpscQueue *self, MpscQueueNode *node)
+{
+    atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+    MpscQueueNode *previous = atomic_exchange_explicit(&self->head, node, memory_order_acq_rel);
+    atomic_store_explicit(&previous->next, node, memory_order_release);
+
+    return CBR_SUCCESS;
+}
+
+/* Consumer side. Returns the oldest node, now owned by the caller, or NULL
+when the queue is empty or its oldest node is still being linked. Only
+acquire loads are needed unless a single node is left */
+MpscQueueNode *MpscQueue__dequeue(MpscQueue *self)
+{
+    MpscQueueNode *stub = &self->stub;
+    MpscQueueNode *tail = self->tail;
+    MpscQueueNode *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if (tail == stub)
+    {
+        if (next == NULL)
+        {
+            return NULL;
+        }
+
+        self->tail = next;
+        tail = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+
+    if (next != NULL)
+    {
+        self->tail = next;
+        return tail;
+    }
+
+    if (tail != atomic_load_explicit(&self->head, memory_order_acquire))
+    {
+        // A producer swapped the head but has not linked its node yet
+        return NULL;
+    }
+
+    // The last node can only leave once something follows it
+    MpscQueue__enqueue(self, stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if (next != NULL)
+    {
+        self->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+/* Consumer side. Detaches every node ready to be dequeued and returns them
+as one chain, oldest first, linked through `next` and ending with NULL. The
+number of nodes is stored in `countAddr` when not NULL */
+MpscQueueNode *MpscQueue__drain(MpscQueue *self, size_t *countAddr)
+{
+    MpscQueueNode *first = MpscQueue__dequeue(self);
+    MpscQueueNode *last = first;
+    size_t count = first != NULL;
+
+    for (MpscQueueNode *node; last != NULL && (node = MpscQueue__dequeue(self)) != NULL; count++)
+    {
+        atomic_store_explicit(&last->next, node, memory_order_relaxed);
+        last = node;
+    }
+
+    if (last != NULL)
+    {
+        atomic_store_explicit(&last->next, NULL, memory_order_relaxed);
+    }
+
+    if (countAddr != NULL)
+    {
+        *countAddr = count;
+    }
+
+    return first;
+}
+
+/* Frees the queue but not the nodes still in it, which belong to the
+caller */
+void MpscQueue__del(MpscQueue *self)
+{
+    free(self);
+}
@@ -0,0 +1,480 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/priorityqueue.h>
+
+#define PRIORITY_QUEUE_MIN_CAPACITY 16
+
+static char *sPriorityQueue__slot(PriorityQueue *self, size_t index)
+{
+    return self->buffer + index * self->elementSize;
+}
+
+/* Moves the parents of `index` down until `value` fits, then stores it
+there, so each level costs one copy instead of a swap */
+static void sPriorityQueue__siftUp(PriorityQueue *self, size_t index, const void *value)
+{
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / self->arity;
+        char *parentSlot = sPriorityQueue__slot(self, parent);
+
+        if (self->compare(value, parentSlot, self->context) >= 0)
+        {
+            break;
+        }
+
+        memcpy(sPriorityQueue__slot(self, index), parentSlot, self->elementSize);
+        index = parent;
+    }
+
+    memcpy(sPriorityQueue__slot(self, index), value, self->elementSize);
+}
+
+/* Moves the best child of `index` up until `value` fits. `value` must not
+point into the heap */
+static void sPriorityQueue__siftDown(PriorityQueue *self, size_t index, const void *value)
+{
+    for (;;)
+    {
+        size_t first = index * self->arity + 1;
+
+        if (first >= self->numberOfElements)
+        {
+            break;
+        }
+
+        size_t last = first + self->arity;
+        size_t best = first;
+
+        if (last > self->numberOfElements)
+        {
+            last = self->numberOfElements;
+        }
+
+        for (size_t child = first + 1; child < last; child++)
+        {
+            if (self->compare(sPriorityQueue__slot(self, child), sPriorityQueue__slot(self, best), self->context) < 0)
+            {
+                best = child;
+            }
+        }
+
+        char *bestSlot = sPriorityQueue__slot(self, best);
+
+        if (self->compare(bestSlot, value, self->context) >= 0)
+        {
+            break;
+        }
+
+        memcpy(sPriorityQueue__slot(self, index), bestSlot, self->elementSize);
+        index = best;
+    }
+
+    memcpy(sPriorityQueue__slot(self, index), value, self->elementSize);
+}
+
+static int8_t sPriorityQueue__reserve(PriorityQueue *self, size_t capacity)
+{
+    if (capacity <= self->capacity)
+    {
+        return CBR_SUCCESS;
+    }
+
+    if (capacity > ((SIZE_MAX >> 1) + 1) / self->elementSize)
+    {
+        fprintf(stderr, "Priority queue capacity overflowed\n");
+        return CBR_ERROR;
+    }
+
+    size_t newCapacity = self->capacity;
+
+    while (newCapacity < capacity)
+    {
+        newCapacity *= 2;
+    }
+
+    char *buffer = realloc(self->buffer, newCapacity * self->elementSize);
+
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the priority queue buffer\n");
+        return CBR_ERROR;
+    }
+
+    self->buffer = buffer;
+    self->capacity = newCapacity;
+
+    return CBR_SUCCESS;
+}
+
+/* Creates an empty queue of `elementSize` byte elements ordered by
+`compare`. An `arity` of 0 picks PRIORITY_QUEUE_DEFAULT_ARITY */
+PriorityQueue *PriorityQueue__new(size_t elementSize,
+                                  size_t arity,
+                                  PriorityQueueCompareFunction compare,
+                                  void *context)
+{
+    if (elementSize == 0 || arity == 1 || compare == NULL)
+    {
+        fprintf(stderr, "Priority queue needs a positive element size, an arity of at least 2 and a comparator\n");
+        return NULL;
+    }
+
+    PriorityQueue *queue = malloc(sizeof(PriorityQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the priority queue\n");
+        return NULL;
+    }
+
+    queue->buffer = malloc(PRIORITY_QUEUE_MIN_CAPACITY * elementSize);
+    queue->scratch = malloc(elementSize);
+
+    if (queue->buffer == NULL || queue->scratch == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the priority queue buffer\n");
+        free(queue->buffer);
+        free(queue->scratch);
+        free(queue);
+        return NULL;
+    }
+
+    queue->elementSize = elementSize;
+    queue->capacity = PRIORITY_QUEUE_MIN_CAPACITY;
+    queue->numberOfElements = 0;
+    queue->arity = arity == 0 ? PRIORITY_QUEUE_DEFAULT_ARITY : arity;
+    queue->compare = compare;
+    queue->context = context;
+
+    return queue;
+}
+
+/* Creates a queue holding a copy of `elements`, heapified bottom-up in O(n)
+rather than with n pushes */
+PriorityQueue *PriorityQueue__fromArray(size_t elementSize,
+                                        size_t arity,
+                                        PriorityQueueCompareFunction compare,
+                                        void *context,
+                                        const void *elements,
+                                        size_t numberOfElements)
+{
+    PriorityQueue *queue = PriorityQueue__new(elementSize, arity, compare, context);
+
+    if (queue == NULL)
+    {
+        return NULL;
+    }
+
+    if (sPriorityQueue__reserve(queue, numberOfElements) == CBR_ERROR)
+    {
+        PriorityQueue__del(queue);
+        return NULL;
+    }
+
+    memcpy(queue->buffer, elements, numberOfElements * elementSize);
+    queue->numberOfElements = numberOfElements;
+
+    if (numberOfElements < 2)
+    {
+        return queue;
+    }
+
+    // Sift down every parent, starting from the last one
+    for (size_t index = (numberOfElements - 2) / queue->arity + 1; index-- > 0;)
+    {
+        memcpy(queue->scratch, sPriorityQueue__slot(queue, index), elementSize);
+        sPriorityQueue__siftDown(queue, index, queue->scratch);
+    }
+
+    return queue;
+}
+
+int8_t PriorityQueue__push(PriorityQueue *self, const void *value)
+{
+    if (sPriorityQueue__reserve(self, self->numberOfElements + 1) == CBR_ERROR)
+    {
+        return CBR_ERROR;
+    }
+
+    self->numberOfElements++;
+    sPriorityQueue__siftUp(self, self->numberOfElements - 1, value);
+
+    return CBR_SUCCESS;
+}
+
+/* Copies the first element into `buffer` and removes it */
+int8_t PriorityQueue__pop(PriorityQueue *self, void *buffer)
+{
+    if (self->numberOfElements == 0)
+    {
+        fprintf(stderr, "Empty priority queue\n");
+        return CBR_ERROR;
+    }
+
+    memcpy(buffer, self->buffer, self->elementSize);
+    self->numberOfElements--;
+
+    if (self->numberOfElements > 0)
+    {
+        memcpy(self->scratch, sPriorityQueue__slot(self, self->numberOfElements), self->elementSize);
+        sPriorityQueue__siftDown(self, 0, self->scratch);
+    }
+
+    return CBR_SUCCESS;
+}
+
+/* Stores the first element in `valueAddr`, borrowed until the next push or
+pop */
+int8_t PriorityQueue__peek(PriorityQueue *self, void **valueAddr)
+{
+    if (self->numberOfElements == 0)
+    {
+        fprintf(stderr, "Empty priority queue\n");
+        return CBR_ERROR;
+    }
+
+    *valueAddr = self->buffer;
+
+    return CBR_SUCCESS;
+}
+
+void PriorityQueue__del(PriorityQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->buffer);
+    free(self->scratch);
+    free(self);
+}
+
+static char *sIndexedPriorityQueue__value(IndexedPriorityQueue *self, uint32_t id)
+{
+    return self->values + (size_t)id * self->elementSize;
+}
+
+static void sIndexedPriorityQueue__place(IndexedPriorityQueue *self, size_t position, uint32_t id)
+{
+    self->heap[position] = id;
+    self->positions[id] = (uint32_t)position;
+}
+
+/* Sifts `id` up from `position`. Only the 4 byte IDs move, the values stay
+put */
+static void sIndexedPriorityQueue__siftUp(IndexedPriorityQueue *self, size_t position, uint32_t id)
+{
+    char *value = sIndexedPriorityQueue__value(self, id);
+
+    while (position > 0)
+    {
+        size_t parent = (position - 1) / self->arity;
+        uint32_t parentId = self->heap[parent];
+
+        if (self->compare(value, sIndexedPriorityQueue__value(self, parentId), self->context) >= 0)
+        {
+            break;
+        }
+
+        sIndexedPriorityQueue__place(self, position, parentId);
+        position = parent;
+    }
+
+    sIndexedPriorityQueue__place(self, position, id);
+}
+
+static void sIndexedPriorityQueue__siftDown(IndexedPriorityQueue *self, size_t position, uint32_t id)
+{
+    char *value = sIndexedPriorityQueue__value(self, id);
+
+    for (;;)
+    {
+        size_t first = position * self->arity + 1;
+
+        if (first >= self->numberOfElements)
+        {
+            break;
+        }
+
+        size_t last = first + self->arity;
+        uint32_t bestId = self->heap[first];
+        size_t best = first;
+
+        if (last > self->numberOfElements)
+        {
+            last = self->numberOfElements;
+        }
+
+        for (size_t child = first + 1; child < last; child++)
+        {
+            uint32_t childId = self->heap[child];
+
+            if (self->compare(sIndexedPriorityQueue__value(self, childId),
+                              sIndexedPriorityQueue__value(self, bestId),
+                              self->context) < 0)
+            {
+                bestId = childId;
+                best = child;
+            }
+        }
+
+        if (self->compare(sIndexedPriorityQueue__value(self, bestId), value, self->context) >= 0)
+        {
+            break;
+        }
+
+        sIndexedPriorityQueue__place(self, position, bestId);
+        position = best;
+    }
+
+    sIndexedPriorityQueue__place(self, position, id);
+}
+
+/* Creates an empty queue over the IDs 0 to `maxIds` - 1. All storage is
+allocated upfront, so pushes never allocate */
+IndexedPriorityQueue *IndexedPriorityQueue__new(size_t elementSize,
+                                                size_t arity,
+                                                uint32_t maxIds,
+                                                PriorityQueueCompareFunction compare,
+                                                void *context)
+{
+    if (elementSize == 0 || arity == 1 || compare == NULL || maxIds == 0 ||
+        maxIds == INDEXED_PRIORITY_QUEUE_ABSENT)
+    {
+        fprintf(stderr, "Indexed priority queue needs a positive element size, an arity of at least 2, a comparator "
+                        "and between 1 and 2^32 - 2 IDs\n");
+        return NULL;
+    }
+
+    IndexedPriorityQueue *queue = malloc(sizeof(IndexedPriorityQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the indexed priority queue\n");
+        return NULL;
+    }
+
+    queue->values = malloc((size_t)maxIds * elementSize);
+    queue->heap = malloc((size_t)maxIds * sizeof(uint32_t));
+    queue->positions = malloc((size_t)maxIds * sizeof(uint32_t));
+
+    if (queue->values == NULL || queue->heap == NULL || queue->positions == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the indexed priority queue buffers\n");
+        IndexedPriorityQueue__del(queue);
+        return NULL;
+    }
+
+    for (uint32_t id = 0; id < maxIds; id++)
+    {
+        queue->positions[id] = INDEXED_PRIORITY_QUEUE_ABSENT;
+    }
+
+    queue->elementSize = elementSize;
+    queue->maxIds = maxIds;
+    queue->numberOfElements = 0;
+    queue->arity = arity == 0 ? PRIORITY_QUEUE_DEFAULT_ARITY : arity;
+    queue->compare = compare;
+    queue->context = context;
+
+    return queue;
+}
+
+/* Queues `id` with a copy of `value`. Fails when the ID is out of range or
+already queued */
+int8_t IndexedPriorityQueue__push(IndexedPriorityQueue *self, uint32_t id, const void *value)
+{
+    if (id >= self->maxIds)
+    {
+        fprintf(stderr, "Indexed priority queue ID out of range\n");
+        return CBR_ERROR;
+    }
+
+    if (self->positions[id] != INDEXED_PRIORITY_QUEUE_ABSENT)
+    {
+        fprintf(stderr, "Indexed priority queue ID already queued\n");
+        return CBR_ERROR;
+    }
+
+    memcpy(sIndexedPriorityQueue__value(self, id), value, self->elementSize);
+    self->numberOfElements++;
+    sIndexedPriorityQueue__siftUp(self, self->numberOfElements - 1, id);
+
+    return CBR_SUCCESS;
+}
+
+/* Replaces the value of a queued `id` with one that comes out no later, as
+relaxing an edge does in Dijkstra's algorithm */
+int8_t IndexedPriorityQueue__decreaseKey(IndexedPriorityQueue *self, uint32_t id, const void *value)
+{
+    if (id >= self->maxIds || self->positions[id] == INDEXED_PRIORITY_QUEUE_ABSENT)
+    {
+        fprintf(stderr, "Indexed priority queue ID is not queued\n");
+        return CBR_ERROR;
+    }
+
+    char *current = sIndexedPriorityQueue__value(self, id);
+
+    if (self->compare(value, current, self->context) > 0)
+    {
+        fprintf(stderr, "Decreased key would come out later than the current one\n");
+        return CBR_ERROR;
+    }
+
+    memcpy(current, value, self->elementSize);
+    sIndexedPriorityQueue__siftUp(self, self->positions[id], id);
+
+    return CBR_SUCCESS;
+}
+
+/* Removes the first ID, storing it in `idAddr` and copying its value into
+`buffer` when not NULL */
+int8_t IndexedPriorityQueue__pop(IndexedPriorityQueue *self, uint32_t *idAddr, void *buffer)
+{
+    if (self->numberOfElements == 0)
+    {
+        fprintf(stderr, "Empty priority queue\n");
+        return CBR_ERROR;
+    }
+
+    uint32_t id = self->heap[0];
+
+    if (buffer != NULL)
+    {
+        memcpy(buffer, sIndexedPriorityQueue__value(self, id), self->elementSize);
+    }
+
+    *idAddr = id;
+    self->positions[id] = INDEXED_PRIORITY_QUEUE_ABSENT;
+    self->numberOfElements--;
+
+    if (self->numberOfElements > 0)
+    {
+        sIndexedPriorityQueue__siftDown(self, 0, self->heap[self->numberOfElements]);
+    }
+
+    return CBR_SUCCESS;
+}
+
+uint8_t IndexedPriorityQueue__contains(IndexedPriorityQueue *self, uint32_t id)
+{
+    return id < self->maxIds && self->positions[id] != INDEXED_PRIORITY_QUEUE_ABSENT;
+}
+
+void IndexedPriorityQueue__del(IndexedPriorityQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->values);
+    free(self->heap);
+    free(self->positions);
+    free(self);
+}
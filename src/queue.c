@@ -81,6 +81,66 @@ int8_t Queue__dequeue(Queue *self, void **valueAddress)
     return CBR_SUCCESS;
 }
 
+/* Copies the head value into `buffer` and removes it, so the consumer has
+nothing to free. The queue still frees the node and its value, so this saves
+the caller's `free` rather than any allocator work. The value size is stored
+in `sizeAddr` when not NULL. When it exceeds `capacity` the value is left in
+the queue, so the caller can retry with a larger buffer */
+int8_t Queue__dequeueInto(Queue *self, void *buffer, size_t capacity, size_t *sizeAddr)
+{
+    if (self->head == NULL)
+    {
+        fprintf(stderr, "Empty queue\n");
+        return CBR_ERROR;
+    }
+
+    if (sizeAddr != NULL)
+    {
+        *sizeAddr = self->head->valueSize;
+    }
+
+    if (self->head->valueSize > capacity)
+    {
+        fprintf(stderr, "Buffer is too small for the queue value\n");
+        return CBR_ERROR;
+    }
+
+    QueueNode *nodeToFree = self->head;
+    memcpy(buffer, nodeToFree->value, nodeToFree->valueSize);
+    self->head = nodeToFree->next;
+    self->numberOfNodes--;
+
+    if (self->head == NULL)
+    {
+        self->tail = NULL;
+    }
+
+    free(nodeToFree->value);
+    free(nodeToFree);
+
+    return CBR_SUCCESS;
+}
+
+/* Stores the head value in `valueAddr`, borrowed until it is dequeued, and
+its size in `sizeAddr` when not NULL */
+int8_t Queue__peek(Queue *self, void **valueAddr, size_t *sizeAddr)
+{
+    if (self->head == NULL)
+    {
+        fprintf(stderr, "Empty queue\n");
+        return CBR_ERROR;
+    }
+
+    *valueAddr = self->head->value;
+
+    if (sizeAddr != NULL)
+    {
+        *sizeAddr = self->head->valueSize;
+    }
+
+    return CBR_SUCCESS;
+}
+
 void Queue__del(Queue *self)
 {
     if (self == NULL)
@@ -90,7 +150,7 @@ void Queue__del(Queue *self)
 
     while (self->numberOfNodes > 0)
     {
-        void *value;
+        void *value = NULL;
         Queue__dequeue(self, &value);
         free(value);
     }
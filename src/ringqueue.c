@@ -0,0 +1,145 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/ringqueue.h>
+
+#define RING_QUEUE_MIN_CAPACITY 16
+
+static char *sRingQueue__slot(RingQueue *self, size_t position)
+{
+    return self->buffer + (position & (self->capacity - 1)) * self->elementSize;
+}
+
+/* Doubles the ring in place. Elements that wrapped around to the start of
+the old ring are moved right after its end, so they follow the head again */
+static int8_t sRingQueue__grow(RingQueue *self)
+{
+    if (self->capacity > SIZE_MAX / 2 / self->elementSize)
+    {
+        fprintf(stderr, "Ring queue capacity overflowed\n");
+        return CBR_ERROR;
+    }
+
+    size_t capacity = self->capacity * 2;
+    char *buffer = realloc(self->buffer, capacity * self->elementSize);
+
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the ring queue buffer\n");
+        return CBR_ERROR;
+    }
+
+    size_t wrapped = self->head + self->numberOfElements - self->capacity;
+
+    memcpy(buffer + self->capacity * self->elementSize, buffer, wrapped * self->elementSize);
+    self->buffer = buffer;
+    self->capacity = capacity;
+
+    return CBR_SUCCESS;
+}
+
+/* Creates a queue of `elementSize` byte elements with room for at least
+`capacity` of them before growing */
+RingQueue *RingQueue__new(size_t elementSize, size_t capacity)
+{
+    if (elementSize == 0)
+    {
+        fprintf(stderr, "Ring queue element size must be positive\n");
+        return NULL;
+    }
+
+    // Rounding up to a power of two at most doubles the capacity, which must
+    // neither wrap around nor overflow the buffer size
+    if (capacity > ((SIZE_MAX >> 1) + 1) / elementSize)
+    {
+        fprintf(stderr, "Ring queue capacity is too large\n");
+        return NULL;
+    }
+
+    RingQueue *queue = malloc(sizeof(RingQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the ring queue\n");
+        return NULL;
+    }
+
+    queue->capacity = RING_QUEUE_MIN_CAPACITY;
+
+    while (queue->capacity < capacity)
+    {
+        queue->capacity *= 2;
+    }
+
+    queue->buffer = malloc(queue->capacity * elementSize);
+
+    if (queue->buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the ring queue buffer\n");
+        free(queue);
+        return NULL;
+    }
+
+    queue->elementSize = elementSize;
+    queue->head = 0;
+    queue->numberOfElements = 0;
+
+    return queue;
+}
+
+int8_t RingQueue__enqueue(RingQueue *self, const void *value)
+{
+    if (self->numberOfElements == self->capacity && sRingQueue__grow(self) == CBR_ERROR)
+    {
+        return CBR_ERROR;
+    }
+
+    memcpy(sRingQueue__slot(self, self->head + self->numberOfElements), value, self->elementSize);
+    self->numberOfElements++;
+
+    return CBR_SUCCESS;
+}
+
+/* Copies the head element into `buffer` and removes it */
+int8_t RingQueue__dequeue(RingQueue *self, void *buffer)
+{
+    if (self->numberOfElements == 0)
+    {
+        fprintf(stderr, "Empty queue\n");
+        return CBR_ERROR;
+    }
+
+    memcpy(buffer, sRingQueue__slot(self, self->head), self->elementSize);
+    self->head = (self->head + 1) & (self->capacity - 1);
+    self->numberOfElements--;
+
+    return CBR_SUCCESS;
+}
+
+/* Stores the head element in `valueAddr`, borrowed until the next enqueue
+or dequeue */
+int8_t RingQueue__peek(RingQueue *self, void **valueAddr)
+{
+    if (self->numberOfElements == 0)
+    {
+        fprintf(stderr, "Empty queue\n");
+        return CBR_ERROR;
+    }
+
+    *valueAddr = sRingQueue__slot(self, self->head);
+
+    return CBR_SUCCESS;
+}
+
+void RingQueue__del(RingQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->buffer);
+    free(self);
+}
@@ -0,0 +1,161 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/spscqueue.h>
+
+/* Copies `count` elements starting at ring position `position` from
+`values`, in two parts when they wrap around the end of the ring */
+static void sSpscQueue__copyIn(SpscQueue *self, size_t position, const char *values, size_t count)
+{
+    size_t offset = position & (self->capacity - 1);
+    size_t first = self->capacity - offset < count ? self->capacity - offset : count;
+
+    memcpy(self->buffer + offset * self->elementSize, values, first * self->elementSize);
+    memcpy(self->buffer, values + first * self->elementSize, (count - first) * self->elementSize);
+}
+
+static void sSpscQueue__copyOut(SpscQueue *self, size_t position, char *values, size_t count)
+{
+    size_t offset = position & (self->capacity - 1);
+    size_t first = self->capacity - offset < count ? self->capacity - offset : count;
+
+    memcpy(values, self->buffer + offset * self->elementSize, first * self->elementSize);
+    memcpy(values + first * self->elementSize, self->buffer, (count - first) * self->elementSize);
+}
+
+/* Creates a queue holding up to `capacity` elements, rounded up to a power
+of two, of `elementSize` bytes */
+SpscQueue *SpscQueue__new(size_t elementSize, size_t capacity)
+{
+    if (elementSize == 0 || capacity == 0)
+    {
+        fprintf(stderr, "SPSC queue capacity and element size must be positive\n");
+        return NULL;
+    }
+
+    if (capacity > ((SIZE_MAX >> 1) + 1) / elementSize)
+    {
+        fprintf(stderr, "SPSC queue capacity is too large\n");
+        return NULL;
+    }
+
+    SpscQueue *queue = aligned_alloc(SPSC_QUEUE_CACHE_LINE, sizeof(SpscQueue));
+
+    if (queue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the SPSC queue\n");
+        return NULL;
+    }
+
+    queue->capacity = 1;
+
+    while (queue->capacity < capacity)
+    {
+        queue->capacity *= 2;
+    }
+
+    queue->buffer = malloc(queue->capacity * elementSize);
+
+    if (queue->buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the SPSC queue buffer\n");
+        free(queue);
+        return NULL;
+    }
+
+    queue->elementSize = elementSize;
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->cachedHead = 0;
+    queue->cachedTail = 0;
+
+    return queue;
+}
+
+/* Producer side. Returns CBR_ERROR, without printing, when the queue is
+full */
+int8_t SpscQueue__enqueue(SpscQueue *self, const void *value)
+{
+    return SpscQueue__enqueueBatch(self, value, 1) == 1 ? CBR_SUCCESS : CBR_ERROR;
+}
+
+/* Consumer side. Returns CBR_ERROR, without printing, when the queue is
+empty */
+int8_t SpscQueue__dequeue(SpscQueue *self, void *buffer)
+{
+    return SpscQueue__dequeueBatch(self, buffer, 1) == 1 ? CBR_SUCCESS : CBR_ERROR;
+}
+
+/* Producer side. Enqueues as many of the `count` elements laid out in
+`values` as fit, publishing them all with a single release store, and
+returns how many were enqueued */
+size_t SpscQueue__enqueueBatch(SpscQueue *self, const void *values, size_t count)
+{
+    size_t tail = atomic_load_explicit(&self->tail, memory_order_relaxed);
+
+    if (self->capacity - (tail - self->cachedHead) < count)
+    {
+        self->cachedHead = atomic_load_explicit(&self->head, memory_order_acquire);
+    }
+
+    size_t room = self->capacity - (tail - self->cachedHead);
+
+    if (count > room)
+    {
+        count = room;
+    }
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    sSpscQueue__copyIn(self, tail, values, count);
+    atomic_store_explicit(&self->tail, tail + count, memory_order_release);
+
+    return count;
+}
+
+/* Consumer side. Dequeues up to `count` elements into `buffer`, releasing
+their slots with a single store, and returns how many were dequeued */
+size_t SpscQueue__dequeueBatch(SpscQueue *self, void *buffer, size_t count)
+{
+    size_t head = atomic_load_explicit(&self->head, memory_order_relaxed);
+
+    if (self->cachedTail - head < count)
+    {
+        self->cachedTail = atomic_load_explicit(&self->tail, memory_order_acquire);
+    }
+
+    size_t available = self->cachedTail - head;
+
+    if (count > available)
+    {
+        count = available;
+    }
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    sSpscQueue__copyOut(self, head, buffer, count);
+    atomic_store_explicit(&self->head, head + count, memory_order_release);
+
+    return count;
+}
+
+/* Frees the queue, which both threads must be done with */
+void SpscQueue__del(SpscQueue *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    free(self->buffer);
+    free(self);
+}
@@ -5,41 +5,130 @@
 #include <cbarroso/constants.h>
 #include <cbarroso/stack.h>
 
+#define STACK_MIN_CAPACITY 64
+#define SIZE_SUFFIX sizeof(size_t)
+#define PADDED_SIZE(size) (((size) + SIZE_SUFFIX - 1) & ~(SIZE_SUFFIX - 1))
+
+/* Returns the size of the top element, read from its suffix unless the
+stack is fixed-size */
+static size_t sStack__topSize(Stack *self)
+{
+    if (self->elementSize != 0)
+    {
+        return self->elementSize;
+    }
+
+    size_t valueSize;
+    memcpy(&valueSize, self->buffer + self->used - SIZE_SUFFIX, SIZE_SUFFIX);
+
+    return valueSize;
+}
+
+/* Points `top` at the value of the element ending at `used` */
+static void sStack__updateTop(Stack *self)
+{
+    if (self->used == 0)
+    {
+        self->top = NULL;
+    }
+    else if (self->elementSize != 0)
+    {
+        self->top = self->buffer + self->used - self->elementSize;
+    }
+    else
+    {
+        self->top = self->buffer + self->used - SIZE_SUFFIX - PADDED_SIZE(sStack__topSize(self));
+    }
+}
+
+static int8_t sStack__reserve(Stack *self, size_t bytes)
+{
+    if (self->capacity - self->used >= bytes)
+    {
+        return CBR_SUCCESS;
+    }
+
+    if (bytes > SIZE_MAX - self->used)
+    {
+        fprintf(stderr, "Parser stack capacity overflowed\n");
+        return CBR_ERROR;
+    }
+
+    size_t capacity = self->capacity == 0 ? STACK_MIN_CAPACITY : self->capacity;
+
+    while (capacity - self->used < bytes)
+    {
+        if (capacity > SIZE_MAX / 2)
+        {
+            capacity = SIZE_MAX;
+            break;
+        }
+
+        capacity *= 2;
+    }
+
+    char *buffer = realloc(self->buffer, capacity);
+
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the parser stack buffer\n");
+        return CBR_ERROR;
+    }
+
+    self->buffer = buffer;
+    self->capacity = capacity;
+
+    return CBR_SUCCESS;
+}
+
+/* Copies `value` onto the stack, only allocating when the buffer has to
+grow */
 int8_t Stack__push(Stack *self,
                    void *value,
                    size_t valueSize)
 {
-    StackNode *node = malloc(sizeof(StackNode));
+    if (self->elementSize != 0 && valueSize != self->elementSize)
+    {
+        fprintf(stderr, "Value size does not match the parser stack element size\n");
+        return CBR_ERROR;
+    }
 
-    if (node == NULL)
+    if (self->elementSize == 0 && valueSize > SIZE_MAX - 2 * SIZE_SUFFIX)
     {
-        fprintf(stderr, "Failed to allocate memory for the parser stack node\n");
+        fprintf(stderr, "Value is too large for the parser stack\n");
         return CBR_ERROR;
     }
 
-    node->value = malloc(valueSize);
+    size_t bytes = self->elementSize != 0 ? valueSize : PADDED_SIZE(valueSize) + SIZE_SUFFIX;
 
-    if (node->value == NULL)
+    if (sStack__reserve(self, bytes) == CBR_ERROR)
     {
-        fprintf(stderr, "Failed to allocate memory for the parser stack node value\n");
         return CBR_ERROR;
     }
 
-    memcpy(node->value, value, valueSize);
-    node->valueSize = valueSize;
+    memcpy(self->buffer + self->used, value, valueSize);
 
-    if (self->stackSize > 0)
-        node->next = self->top;
-    else
-        node->next = NULL;
+    if (self->elementSize == 0)
+    {
+        memcpy(self->buffer + self->used + bytes - SIZE_SUFFIX, &valueSize, SIZE_SUFFIX);
+    }
 
-    self->top = node;
+    self->used += bytes;
     self->stackSize++;
+    sStack__updateTop(self);
 
     return CBR_SUCCESS;
 }
 
+/* Creates a stack of elements of any size */
 Stack *Stack__new()
+{
+    return Stack__newFixed(0);
+}
+
+/* Creates a stack whose elements all have `elementSize` bytes, stored
+without any per-element overhead. An `elementSize` of 0 accepts any size */
+Stack *Stack__newFixed(size_t elementSize)
 {
     Stack *stack = malloc(sizeof(Stack));
 
@@ -51,10 +140,16 @@ Stack *Stack__new()
 
     stack->top = NULL;
     stack->stackSize = 0;
+    stack->elementSize = elementSize;
+    stack->buffer = NULL;
+    stack->used = 0;
+    stack->capacity = 0;
 
     return stack;
 }
 
+/* Stores a copy of the top element in `valueAddress`, to be freed by the
+caller, and removes it */
 int8_t Stack__pop(Stack *self, void **valueAddress)
 {
     if (self->top == NULL)
@@ -63,24 +158,107 @@ int8_t Stack__pop(Stack *self, void **valueAddress)
         return CBR_ERROR;
     }
 
-    *valueAddress = self->top->value;
-    StackNode *newTop = self->top->next;
-    free(self->top);
-    self->top = newTop;
+    size_t valueSize = sStack__topSize(self);
+    void *value = malloc(valueSize == 0 ? 1 : valueSize);
+
+    if (value == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the parser stack value\n");
+        return CBR_ERROR;
+    }
+
+    memcpy(value, self->top, valueSize);
+    *valueAddress = value;
+    self->used = (size_t)((char *)self->top - self->buffer);
+    self->stackSize--;
+    sStack__updateTop(self);
+
+    return CBR_SUCCESS;
+}
+
+/* Copies the top element into `buffer` and removes it, without allocating.
+The element size is stored in `sizeAddr` when not NULL. When it exceeds
+`capacity` the element is left on the stack, so the caller can retry with a
+larger buffer */
+int8_t Stack__popInto(Stack *self, void *buffer, size_t capacity, size_t *sizeAddr)
+{
+    if (self->top == NULL)
+    {
+        fprintf(stderr, "Empty stack\n");
+        return CBR_ERROR;
+    }
+
+    size_t valueSize = sStack__topSize(self);
+
+    if (sizeAddr != NULL)
+    {
+        *sizeAddr = valueSize;
+    }
+
+    if (valueSize > capacity)
+    {
+        fprintf(stderr, "Buffer is too small for the parser stack value\n");
+        return CBR_ERROR;
+    }
+
+    memcpy(buffer, self->top, valueSize);
+    self->used = (size_t)((char *)self->top - self->buffer);
     self->stackSize--;
+    sStack__updateTop(self);
 
     return CBR_SUCCESS;
 }
 
-Stack *Stack__del(Stack *self)
+/* Stores the top element in `valueAddr`, borrowed until the next push or
+pop, and its size in `sizeAddr` when not NULL */
+int8_t Stack__peek(Stack *self, void **valueAddr, size_t *sizeAddr)
 {
-    while (self->stackSize > 0)
+    if (self->top == NULL)
+    {
+        fprintf(stderr, "Empty stack\n");
+        return CBR_ERROR;
+    }
+
+    *valueAddr = self->top;
+
+    if (sizeAddr != NULL)
     {
-        void *value;
-        Stack__pop(self, &value);
-        free(value);
+        *sizeAddr = sStack__topSize(self);
     }
 
+    return CBR_SUCCESS;
+}
+
+/* Returns a token for the current position. Marks nest: rolling back to
+one discards any mark taken after it */
+StackMark Stack__mark(Stack *self)
+{
+    StackMark mark = {self->used, self->stackSize};
+
+    return mark;
+}
+
+/* Discards every element pushed since `mark` in O(1), the elements living
+in the stack buffer. The mark is no longer valid once the stack has been
+popped below it */
+int8_t Stack__rollback(Stack *self, StackMark mark)
+{
+    if (mark.used > self->used || mark.stackSize > self->stackSize)
+    {
+        fprintf(stderr, "Parser stack mark is past the top of the stack\n");
+        return CBR_ERROR;
+    }
+
+    self->used = mark.used;
+    self->stackSize = mark.stackSize;
+    sStack__updateTop(self);
+
+    return CBR_SUCCESS;
+}
+
+Stack *Stack__del(Stack *self)
+{
+    free(self->buffer);
     free(self);
     return NULL;
 }
@@ -0,0 +1,247 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/_hash.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/symboltable.h>
+
+#define PERTURB_SHIFT 5
+#define SYMBOL_TABLE_MIN_LOG2_SLOTS 3
+
+/* Walks the probe sequence of `hash` and returns the slot holding `key`, or
+the empty slot ending the sequence. Stored hashes are compared before bytes
+so a probe rarely touches the arena of another symbol */
+static size_t sSymbolTable__probe(SymbolTable *self, const void *key, size_t keySize, hash_t hash)
+{
+    size_t mask = ((size_t)1 << self->log2_slots) - 1;
+    size_t slot = (size_t)hash & mask;
+
+    for (size_t perturb = hash; self->slots[slot] != 0;)
+    {
+        SymbolTableSymbol *symbol = &self->symbols[self->slots[slot] - 1];
+
+        if (symbol->hash == hash &&
+            symbol->size == keySize &&
+            memcmp(symbol->data, key, keySize) == 0)
+        {
+            return slot;
+        }
+
+        perturb >>= PERTURB_SHIFT;
+        slot = mask & (slot * 5 + perturb + 1);
+    }
+
+    return slot;
+}
+
+/* Rebuilds the index with twice the slots from the hashes kept alongside
+the symbols, without hashing any string again */
+static int8_t sSymbolTable__grow(SymbolTable *self)
+{
+    uint8_t log2_slots = self->log2_slots + 1;
+    size_t mask = ((size_t)1 << log2_slots) - 1;
+    uint32_t *slots = calloc(mask + 1, sizeof(uint32_t));
+
+    if (slots == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the symbol table index\n");
+        return CBR_ERROR;
+    }
+
+    for (uint32_t id = 0; id < self->numberOfSymbols; id++)
+    {
+        hash_t hash = self->symbols[id].hash;
+        size_t slot = (size_t)hash & mask;
+
+        for (size_t perturb = hash; slots[slot] != 0;)
+        {
+            perturb >>= PERTURB_SHIFT;
+            slot = mask & (slot * 5 + perturb + 1);
+        }
+
+        slots[slot] = id + 1;
+    }
+
+    free(self->slots);
+    self->slots = slots;
+    self->log2_slots = log2_slots;
+
+    return CBR_SUCCESS;
+}
+
+/* Copies `size` bytes and a terminating NUL into the arena */
+static const char *sSymbolTable__store(SymbolTable *self, const void *key, size_t size)
+{
+    SymbolTableBlock *block = self->blocks;
+
+    if (block == NULL || block->capacity - block->used < size + 1)
+    {
+        size_t capacity = size + 1 > SYMBOL_TABLE_BLOCK_SIZE ? size + 1 : SYMBOL_TABLE_BLOCK_SIZE;
+        block = malloc(sizeof(SymbolTableBlock) + capacity);
+
+        if (block == NULL)
+        {
+            fprintf(stderr, "Failed to allocate memory for the symbol table arena\n");
+            return NULL;
+        }
+
+        block->used = 0;
+        block->capacity = capacity;
+
+        // Oversized strings fill their block, keep appending to the current one
+        if (capacity > SYMBOL_TABLE_BLOCK_SIZE && self->blocks != NULL)
+        {
+            block->next = self->blocks->next;
+            self->blocks->next = block;
+        }
+        else
+        {
+            block->next = self->blocks;
+            self->blocks = block;
+        }
+    }
+
+    char *data = block->data + block->used;
+    memcpy(data, key, size);
+    data[size] = '\0';
+    block->used += size + 1;
+
+    return data;
+}
+
+SymbolTable *SymbolTable__new(void)
+{
+    SymbolTable *table = calloc(1, sizeof(SymbolTable));
+
+    if (table == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the symbol table\n");
+        return NULL;
+    }
+
+    table->log2_slots = SYMBOL_TABLE_MIN_LOG2_SLOTS;
+    table->slots = calloc((size_t)1 << table->log2_slots, sizeof(uint32_t));
+
+    if (table->slots == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the symbol table index\n");
+        free(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+/* Stores `id` of `key`, interning it first if needed. IDs are dense and
+given in interning order, starting at 0 */
+int8_t SymbolTable__intern(SymbolTable *self, const void *key, size_t keySize, uint32_t *idAddr)
+{
+    hash_t hash = hashBuffer(key, keySize);
+    size_t slot = sSymbolTable__probe(self, key, keySize, hash);
+
+    if (self->slots[slot] != 0)
+    {
+        *idAddr = self->slots[slot] - 1;
+        return CBR_SUCCESS;
+    }
+
+    if (self->numberOfSymbols == SYMBOL_TABLE_NO_ID)
+    {
+        fprintf(stderr, "Symbol table is full\n");
+        return CBR_ERROR;
+    }
+
+    // Keep the index at most two thirds full, as HashMap does. Growing
+    // before storing anything means a failure leaves no half-interned key
+    if ((size_t)(self->numberOfSymbols + 1) * 3 >= ((size_t)2 << self->log2_slots))
+    {
+        if (sSymbolTable__grow(self) == CBR_ERROR)
+        {
+            return CBR_ERROR;
+        }
+
+        slot = sSymbolTable__probe(self, key, keySize, hash);
+    }
+
+    if (self->numberOfSymbols == self->symbolsCapacity)
+    {
+        uint32_t capacity = self->symbolsCapacity == 0 ? 16 : self->symbolsCapacity * 2;
+        SymbolTableSymbol *symbols = realloc(self->symbols, sizeof(SymbolTableSymbol) * capacity);
+
+        if (symbols == NULL)
+        {
+            fprintf(stderr, "Failed to allocate memory for the symbols\n");
+            return CBR_ERROR;
+        }
+
+        self->symbols = symbols;
+        self->symbolsCapacity = capacity;
+    }
+
+    const char *data = sSymbolTable__store(self, key, keySize);
+
+    if (data == NULL)
+    {
+        return CBR_ERROR;
+    }
+
+    uint32_t id = self->numberOfSymbols++;
+    self->symbols[id].data = data;
+    self->symbols[id].size = keySize;
+    self->symbols[id].hash = hash;
+    self->slots[slot] = id + 1;
+    *idAddr = id;
+
+    return CBR_SUCCESS;
+}
+
+/* Stores the ID of `key` without interning it, `SYMBOL_TABLE_NO_ID` if it
+was never interned */
+int8_t SymbolTable__find(SymbolTable *self, const void *key, size_t keySize, uint32_t *idAddr)
+{
+    size_t slot = sSymbolTable__probe(self, key, keySize, hashBuffer(key, keySize));
+
+    *idAddr = self->slots[slot] == 0 ? SYMBOL_TABLE_NO_ID : self->slots[slot] - 1;
+
+    return CBR_SUCCESS;
+}
+
+/* Returns the bytes interned as `id`, NUL terminated, and their size in
+`sizeAddr` when not NULL. They are owned by the table */
+const char *SymbolTable__lookup(SymbolTable *self, uint32_t id, size_t *sizeAddr)
+{
+    if (id >= self->numberOfSymbols)
+    {
+        fprintf(stderr, "Symbol ID out of range\n");
+        return NULL;
+    }
+
+    if (sizeAddr != NULL)
+    {
+        *sizeAddr = self->symbols[id].size;
+    }
+
+    return self->symbols[id].data;
+}
+
+void SymbolTable__del(SymbolTable *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    SymbolTableBlock *block = self->blocks;
+
+    while (block != NULL)
+    {
+        SymbolTableBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    free(self->symbols);
+    free(self->slots);
+    free(self);
+}
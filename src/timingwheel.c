@@ -0,0 +1,272 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/timingwheel.h>
+
+#define SLOT_MASK (TIMING_WHEEL_SLOTS - 1)
+/* Level used for timers parked in the `due` list */
+#define DUE_LEVEL TIMING_WHEEL_LEVELS
+
+static uint8_t sCountTrailingZeros(uint64_t bits)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_ctzll(bits);
+#else
+    uint8_t count = 0;
+
+    while ((bits & 1) == 0)
+    {
+        bits >>= 1;
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+TimingWheel *TimingWheel__new(uint64_t now)
+{
+    TimingWheel *wheel = calloc(1, sizeof(TimingWheel));
+
+    if (wheel == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the timing wheel\n");
+        return NULL;
+    }
+
+    wheel->now = now;
+
+    return wheel;
+}
+
+void TimingWheelTimer__init(TimingWheelTimer *self, void *context)
+{
+    self->deadline = 0;
+    self->prev = NULL;
+    self->next = NULL;
+    self->level = -1;
+    self->slot = 0;
+    self->context = context;
+}
+
+static void sTimingWheel__pushSlot(TimingWheel *self, TimingWheelTimer *timer, uint8_t level, uint8_t slot)
+{
+    TimingWheelTimer **head = &self->slots[level][slot];
+
+    timer->level = (int8_t)level;
+    timer->slot = slot;
+    timer->prev = NULL;
+    timer->next = *head;
+
+    if (*head != NULL)
+    {
+        (*head)->prev = timer;
+    }
+
+    *head = timer;
+    self->occupied[level] |= (uint64_t)1 << slot;
+}
+
+/* Files a timer whose deadline is not before `now` in the level where the
+distance to its deadline falls */
+static void sTimingWheel__place(TimingWheel *self, TimingWheelTimer *timer)
+{
+    uint64_t delta = timer->deadline - self->now;
+    uint8_t level = 0;
+
+    while (level < TIMING_WHEEL_LEVELS - 1 &&
+           delta >= (uint64_t)1 << (TIMING_WHEEL_SLOT_BITS * (level + 1)))
+    {
+        level++;
+    }
+
+    uint8_t slot = (timer->deadline >> (TIMING_WHEEL_SLOT_BITS * level)) & SLOT_MASK;
+    sTimingWheel__pushSlot(self, timer, level, slot);
+}
+
+/* Schedules `timer` to expire at `deadline`, rescheduling it if it was
+already pending. Deadlines that already passed expire on the next advance */
+void TimingWheel__schedule(TimingWheel *self, TimingWheelTimer *timer, uint64_t deadline)
+{
+    TimingWheel__cancel(self, timer);
+
+    timer->deadline = deadline > self->now ? deadline : self->now + 1;
+    sTimingWheel__place(self, timer);
+    self->numberOfTimers++;
+}
+
+void TimingWheel__cancel(TimingWheel *self, TimingWheelTimer *timer)
+{
+    if (timer->level < 0)
+    {
+        return;
+    }
+
+    if (timer->prev != NULL)
+    {
+        timer->prev->next = timer->next;
+    }
+    else if (timer->level == DUE_LEVEL)
+    {
+        self->due = timer->next;
+    }
+    else
+    {
+        self->slots[timer->level][timer->slot] = timer->next;
+
+        if (timer->next == NULL)
+        {
+            self->occupied[timer->level] &= ~((uint64_t)1 << timer->slot);
+        }
+    }
+
+    if (timer->next != NULL)
+    {
+        timer->next->prev = timer->prev;
+    }
+
+    timer->prev = NULL;
+    timer->next = NULL;
+    timer->level = -1;
+    self->numberOfTimers--;
+}
+
+static TimingWheelTimer *sTimingWheel__takeSlot(TimingWheel *self, uint8_t level, uint8_t slot)
+{
+    TimingWheelTimer *head = self->slots[level][slot];
+
+    self->slots[level][slot] = NULL;
+    self->occupied[level] &= ~((uint64_t)1 << slot);
+
+    return head;
+}
+
+/* Returns the next tick at which a slot must be cascaded or expired, or
+`UINT64_MAX` when the wheel is empty. The slot under the current position of
+a level counts as a whole turn away, since it was handled when reached */
+static uint64_t sTimingWheel__nextEvent(TimingWheel *self)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (uint8_t level = 0; level < TIMING_WHEEL_LEVELS; level++)
+    {
+        uint64_t bits = self->occupied[level];
+
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        uint8_t shift = TIMING_WHEEL_SLOT_BITS * level;
+        uint8_t start = ((self->now >> shift) + 1) & SLOT_MASK;
+        uint64_t rotated = start == 0 ? bits : (bits >> start) | (bits << (TIMING_WHEEL_SLOTS - start));
+        uint64_t distance = (uint64_t)sCountTrailingZeros(rotated) + 1;
+        uint64_t slotStart = self->now & ~(((uint64_t)1 << shift) - 1);
+        uint64_t tick = slotStart + (distance << shift);
+
+        if (tick < next)
+        {
+            next = tick;
+        }
+    }
+
+    return next;
+}
+
+static size_t sTimingWheel__expireDue(TimingWheel *self,
+                                      size_t maxExpired,
+                                      TimingWheelExpireFunction onExpire,
+                                      void *context)
+{
+    size_t expired = 0;
+
+    while (self->due != NULL && expired < maxExpired)
+    {
+        TimingWheelTimer *timer = self->due;
+        self->due = timer->next;
+
+        if (self->due != NULL)
+        {
+            self->due->prev = NULL;
+        }
+
+        timer->next = NULL;
+        timer->level = -1;
+        self->numberOfTimers--;
+        expired++;
+        // The callback may free or reschedule the timer
+        onExpire(timer, context);
+    }
+
+    return expired;
+}
+
+/* Moves the clock forward to `now`, calling `onExpire` for every timer
+whose deadline is reached, at most `maxExpired` of them. Only the slots that
+hold timers are visited, so the cost follows the number of timers expired or
+cascaded rather than the number of ticks elapsed. Returns the number of timers
+expired; any left over for lack of budget expire first on the next call */
+size_t TimingWheel__advance(TimingWheel *self,
+                            uint64_t now,
+                            size_t maxExpired,
+                            TimingWheelExpireFunction onExpire,
+                            void *context)
+{
+    size_t expired = sTimingWheel__expireDue(self, maxExpired, onExpire, context);
+
+    while (self->due == NULL)
+    {
+        uint64_t tick = sTimingWheel__nextEvent(self);
+
+        if (tick > now)
+        {
+            break;
+        }
+
+        self->now = tick;
+
+        // Cascade from the top so timers can fall through several levels
+        for (int8_t level = TIMING_WHEEL_LEVELS - 1; level > 0; level--)
+        {
+            uint8_t shift = TIMING_WHEEL_SLOT_BITS * level;
+
+            if ((tick & (((uint64_t)1 << shift) - 1)) != 0)
+            {
+                continue;
+            }
+
+            TimingWheelTimer *timer = sTimingWheel__takeSlot(self, level, (tick >> shift) & SLOT_MASK);
+
+            while (timer != NULL)
+            {
+                TimingWheelTimer *next = timer->next;
+                sTimingWheel__place(self, timer);
+                timer = next;
+            }
+        }
+
+        TimingWheelTimer *due = sTimingWheel__takeSlot(self, 0, tick & SLOT_MASK);
+
+        for (TimingWheelTimer *timer = due; timer != NULL; timer = timer->next)
+        {
+            timer->level = DUE_LEVEL;
+        }
+
+        self->due = due;
+        expired += sTimingWheel__expireDue(self, maxExpired - expired, onExpire, context);
+    }
+
+    if (self->due == NULL && self->now < now)
+    {
+        self->now = now;
+    }
+
+    return expired;
+}
+
+void TimingWheel__del(TimingWheel *self)
+{
+    free(self);
+}
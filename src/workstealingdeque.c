@@ -0,0 +1,215 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <cbarroso/constants.h>
+#include <cbarroso/workstealingdeque.h>
+
+/* Largest power of two array whose size in bytes fits in a size_t */
+#define MAX_CAPACITY (((SIZE_MAX >> 1) + 1) / sizeof(_Atomic(void *)) / 2)
+
+static WorkStealingBuffer *sWorkStealingBuffer__new(size_t capacity)
+{
+    WorkStealingBuffer *buffer = malloc(sizeof(WorkStealingBuffer) + capacity * sizeof(_Atomic(void *)));
+
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the work stealing deque buffer\n");
+        return NULL;
+    }
+
+    buffer->capacity = capacity;
+    buffer->previous = NULL;
+
+    return buffer;
+}
+
+static _Atomic(void *) *sWorkStealingBuffer__slot(WorkStealingBuffer *self, int64_t position)
+{
+    return &self->items[(size_t)position & (self->capacity - 1)];
+}
+
+/* Owner side. Copies the live items into an array twice as large and
+publishes it, keeping the old one reachable from the new one */
+static WorkStealingBuffer *sWorkStealingDeque__grow(WorkStealingDeque *self,
+                                                    WorkStealingBuffer *buffer,
+                                                    int64_t top,
+                                                    int64_t bottom)
+{
+    if (buffer->capacity >= MAX_CAPACITY)
+    {
+        fprintf(stderr, "Work stealing deque capacity overflowed\n");
+        return NULL;
+    }
+
+    WorkStealingBuffer *grown = sWorkStealingBuffer__new(buffer->capacity * 2);
+
+    if (grown == NULL)
+    {
+        return NULL;
+    }
+
+    for (int64_t position = top; position < bottom; position++)
+    {
+        void *item = atomic_load_explicit(sWorkStealingBuffer__slot(buffer, position), memory_order_relaxed);
+        atomic_store_explicit(sWorkStealingBuffer__slot(grown, position), item, memory_order_relaxed);
+    }
+
+    grown->previous = buffer;
+    atomic_store_explicit(&self->buffer, grown, memory_order_release);
+
+    return grown;
+}
+
+/* Creates a deque with room for `capacity` items, rounded up to a power of
+two, before its array grows */
+WorkStealingDeque *WorkStealingDeque__new(size_t capacity)
+{
+    if (capacity > MAX_CAPACITY)
+    {
+        fprintf(stderr, "Work stealing deque capacity is too large\n");
+        return NULL;
+    }
+
+    WorkStealingDeque *deque = aligned_alloc(WORK_STEALING_DEQUE_CACHE_LINE, sizeof(WorkStealingDeque));
+
+    if (deque == NULL)
+    {
+        fprintf(stderr, "Failed to allocate memory for the work stealing deque\n");
+        return NULL;
+    }
+
+    size_t roundedCapacity = 2;
+
+    while (roundedCapacity < capacity)
+    {
+        roundedCapacity *= 2;
+    }
+
+    WorkStealingBuffer *buffer = sWorkStealingBuffer__new(roundedCapacity);
+
+    if (buffer == NULL)
+    {
+        free(deque);
+        return NULL;
+    }
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, buffer);
+
+    return deque;
+}
+
+/* Owner side. Pushes `item` at the bottom, growing the array when full */
+int8_t WorkStealingDeque__push(WorkStealingDeque *self, void *item)
+{
+    int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&self->top, memory_order_acquire);
+    WorkStealingBuffer *buffer = atomic_load_explicit(&self->buffer, memory_order_relaxed);
+
+    if (bottom - top > (int64_t)buffer->capacity - 1)
+    {
+        buffer = sWorkStealingDeque__grow(self, buffer, top, bottom);
+
+        if (buffer == NULL)
+        {
+            return CBR_ERROR;
+        }
+    }
+
+    atomic_store_explicit(sWorkStealingBuffer__slot(buffer, bottom), item, memory_order_relaxed);
+    // Publish the item before the bottom that makes it stealable
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+
+    return CBR_SUCCESS;
+}
+
+/* Owner side. Pops the most recently pushed item into `itemAddr`. Returns
+CBR_ERROR, without printing, when the deque is empty or a thief took the
+last item */
+int8_t WorkStealingDeque__pop(WorkStealingDeque *self, void **itemAddr)
+{
+    int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed) - 1;
+    WorkStealingBuffer *buffer = atomic_load_explicit(&self->buffer, memory_order_relaxed);
+
+    atomic_store_explicit(&self->bottom, bottom, memory_order_relaxed);
+    // Claiming the bottom item must be visible before top is read, or the
+    // owner and a thief could both take it
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&self->top, memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+        return CBR_ERROR;
+    }
+
+    void *item = atomic_load_explicit(sWorkStealingBuffer__slot(buffer, bottom), memory_order_relaxed);
+
+    if (top == bottom)
+    {
+        // Last item, race the thieves for it
+        uint8_t won = atomic_compare_exchange_strong_explicit(&self->top, &top, top + 1, memory_order_seq_cst,
+                                                              memory_order_relaxed);
+        atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+
+        if (!won)
+        {
+            return CBR_ERROR;
+        }
+    }
+
+    *itemAddr = item;
+
+    return CBR_SUCCESS;
+}
+
+/* Thief side, callable from any thread. Steals the oldest item into
+`itemAddr`. Returns CBR_ERROR, without printing, when the deque is empty or
+another thread won the item, in which case the caller may retry */
+int8_t WorkStealingDeque__steal(WorkStealingDeque *self, void **itemAddr)
+{
+    int64_t top = atomic_load_explicit(&self->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_acquire);
+
+    if (top >= bottom)
+    {
+        return CBR_ERROR;
+    }
+
+    WorkStealingBuffer *buffer = atomic_load_explicit(&self->buffer, memory_order_acquire);
+    void *item = atomic_load_explicit(sWorkStealingBuffer__slot(buffer, top), memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&self->top, &top, top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed))
+    {
+        return CBR_ERROR;
+    }
+
+    *itemAddr = item;
+
+    return CBR_SUCCESS;
+}
+
+/* Frees the deque and every array it used. No thread may still be using it */
+void WorkStealingDeque__del(WorkStealingDeque *self)
+{
+    if (self == NULL)
+    {
+        return;
+    }
+
+    WorkStealingBuffer *buffer = atomic_load_explicit(&self->buffer, memory_order_relaxed);
+
+    while (buffer != NULL)
+    {
+        WorkStealingBuffer *previous = buffer->previous;
+        free(buffer);
+        buffer = previous;
+    }
+
+    free(self);
+}
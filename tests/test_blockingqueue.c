@@ -0,0 +1,99 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <cbarroso/blockingqueue.h>
+#include <ccauchy.h>
+
+#define BURSTS 200
+#define BURST_SIZE 50
+
+static void *sBurstProducer(void *argument)
+{
+    BlockingQueue *queue = argument;
+    struct timespec pause = {0, 100000};
+
+    for (int burst = 0; burst < BURSTS; burst++)
+    {
+        for (int i = 0; i < BURST_SIZE; i++)
+        {
+            int value = burst * BURST_SIZE + i;
+            BlockingQueue__enqueue(queue, &value);
+        }
+
+        nanosleep(&pause, NULL);
+    }
+
+    return NULL;
+}
+
+// Test: Create a new BlockingQueue
+TEST(test_blockingqueue_new)
+{
+    BlockingQueue *queue = BlockingQueue__new(sizeof(int));
+    ASSERT_NOT_NULL(queue, "BlockingQueue should not be NULL");
+    ASSERT_EQ(queue->waiters, 0, "Nobody should be waiting");
+    BlockingQueue__del(queue);
+}
+
+// Test: Waiting on an empty queue times out
+TEST(test_blockingqueue_timeout)
+{
+    BlockingQueue *queue = BlockingQueue__new(sizeof(int));
+    struct timespec start, end;
+    int value = 0;
+
+    ASSERT_EQ(BlockingQueue__dequeueWait(queue, &value, 0), -1, "Zero timeout should only check");
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ASSERT_EQ(BlockingQueue__dequeueWait(queue, &value, 20000000), -1, "Wait should time out");
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long elapsed = (end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec);
+    ASSERT(elapsed >= 20000000, "Wait should last until the timeout");
+
+    value = 5;
+    BlockingQueue__enqueue(queue, &value);
+    value = 0;
+    ASSERT_EQ(BlockingQueue__dequeueWait(queue, &value, 0), 0, "Queued element should be returned");
+    ASSERT_EQ(value, 5, "Value should match");
+
+    BlockingQueue__del(queue);
+}
+
+// Test: Batches drain bursts in order across threads
+TEST(test_blockingqueue_batches)
+{
+    BlockingQueue *queue = BlockingQueue__new(sizeof(int));
+    pthread_t producer;
+    int values[64];
+    int expected = 0;
+    int ordered = 1;
+    int wakeups = 0;
+
+    pthread_create(&producer, NULL, sBurstProducer, queue);
+
+    while (expected < BURSTS * BURST_SIZE)
+    {
+        size_t count = 0;
+
+        if (BlockingQueue__dequeueBatch(queue, values, 64, BLOCKING_QUEUE_WAIT_FOREVER, &count) == 0)
+        {
+            wakeups++;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ordered &= values[i] == expected++;
+        }
+    }
+
+    pthread_join(producer, NULL);
+    ASSERT(ordered, "Elements should arrive in order");
+    ASSERT(wakeups < BURSTS * BURST_SIZE, "Batches should serve several elements per wake-up");
+
+    size_t count = 0;
+    ASSERT_EQ(BlockingQueue__dequeueBatch(queue, values, 64, 0, &count), -1, "Queue should be drained");
+    ASSERT_EQ(count, 0, "Nothing should be dequeued");
+
+    BlockingQueue__del(queue);
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cbarroso/bloomfilter.h>
+#include <ccauchy.h>
+
+// Test: Create a new BloomFilter sized from a false positive rate
+TEST(test_bloomfilter_new)
+{
+    BloomFilter *filter = BloomFilter__new(10000, 0.01, 1, 2);
+    ASSERT_NOT_NULL(filter, "BloomFilter should not be NULL");
+    ASSERT(filter->numberOfBlocks * BLOOM_FILTER_BLOCK_BITS >= 10000 * 9, "Filter should get about 10 bits per item");
+    ASSERT_EQ(filter->numberOfHashes, 7, "1% rate should use 7 hashes");
+    ASSERT(BloomFilter__new(10, 1.5, 0, 0) == NULL, "Invalid rate should be rejected");
+    BloomFilter__del(filter);
+}
+
+// Test: No false negatives and a false positive rate near the target
+TEST(test_bloomfilter_false_positives)
+{
+    BloomFilter *filter = BloomFilter__new(10000, 0.01, 3, 4);
+    int keys[10000];
+    void *keyAddrs[10000];
+    size_t keySizes[10000];
+
+    for (int i = 0; i < 10000; i++)
+    {
+        keys[i] = i;
+        keyAddrs[i] = &keys[i];
+        keySizes[i] = sizeof(int);
+    }
+
+    BloomFilter__addBatch(filter, keyAddrs, keySizes, 5000);
+
+    for (int i = 5000; i < 10000; i++)
+    {
+        BloomFilter__add(filter, &keys[i], sizeof(int));
+    }
+
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT(BloomFilter__mayContain(filter, &i, sizeof(int)), "Added key should always be reported");
+    }
+
+    int falsePositives = 0;
+
+    for (int i = 10000; i < 110000; i++)
+    {
+        falsePositives += BloomFilter__mayContain(filter, &i, sizeof(int));
+    }
+
+    ASSERT(falsePositives < 2000, "False positive rate should stay near the target");
+
+    BloomFilter__del(filter);
+}
+
+// Test: Pre-hashed keys, such as HashMap hashes
+TEST(test_bloomfilter_hashed)
+{
+    BloomFilter *filter = BloomFilter__new(100, 0.001, 0, 0);
+    const char *present = "present";
+    const char *absent = "absent";
+
+    BloomFilter__addHashed(filter, hashBuffer(present, 7));
+    ASSERT(BloomFilter__mayContainHashed(filter, hashBuffer(present, 7)), "Hashed key should be reported");
+    ASSERT(!BloomFilter__mayContainHashed(filter, hashBuffer(absent, 6)), "Absent key should not be reported");
+
+    BloomFilter__del(filter);
+}
+
+// Test: Serialize and deserialize round trip
+TEST(test_bloomfilter_serialize)
+{
+    BloomFilter *filter = BloomFilter__new(1000, 0.01, 5, 6);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        BloomFilter__add(filter, &i, sizeof(int));
+    }
+
+    size_t size = BloomFilter__serializedSize(filter);
+    unsigned char *buffer = malloc(size);
+    ASSERT_EQ(BloomFilter__serialize(filter, buffer, size - 1), -1, "Short buffer should be rejected");
+    ASSERT_EQ(BloomFilter__serialize(filter, buffer, size), 0, "Serialize should succeed");
+
+    ASSERT(BloomFilter__deserialize(buffer, size - 1) == NULL, "Truncated buffer should be rejected");
+    BloomFilter *copy = BloomFilter__deserialize(buffer, size);
+    ASSERT_NOT_NULL(copy, "Deserialize should succeed");
+    ASSERT_EQ(copy->numberOfBlocks, filter->numberOfBlocks, "Block count should round trip");
+    ASSERT_EQ(copy->k0, 5, "Hash key should round trip");
+
+    for (int i = 0; i < 2000; i++)
+    {
+        ASSERT_EQ(BloomFilter__mayContain(copy, &i, sizeof(int)),
+                  BloomFilter__mayContain(filter, &i, sizeof(int)),
+                  "Copy should answer like the original");
+    }
+
+    free(buffer);
+    BloomFilter__del(copy);
+    BloomFilter__del(filter);
+}
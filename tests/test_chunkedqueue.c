@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <cbarroso/chunkedqueue.h>
+#include <ccauchy.h>
+
+// Test: Create a new ChunkedQueue
+TEST(test_chunkedqueue_new)
+{
+    ChunkedQueue *queue = ChunkedQueue__new(sizeof(int));
+    ASSERT_NOT_NULL(queue, "ChunkedQueue should not be NULL");
+    ASSERT_EQ(queue->numberOfElements, 0, "ChunkedQueue should be empty");
+    ASSERT(queue->head == queue->tail, "An empty queue should hold a single block");
+
+    int value;
+    ASSERT_EQ(ChunkedQueue__dequeue(queue, &value), -1, "Dequeue on empty queue should fail");
+    ChunkedQueue__del(queue);
+}
+
+// Test: FIFO order is kept across block boundaries
+TEST(test_chunkedqueue_fifo_across_blocks)
+{
+    ChunkedQueue *queue = ChunkedQueue__new(sizeof(int));
+    int count = CHUNKED_QUEUE_BLOCK_ELEMENTS * 3 + 17;
+
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_EQ(ChunkedQueue__enqueue(queue, &i), 0, "Enqueue should succeed");
+    }
+
+    ASSERT_EQ(queue->numberOfElements, count, "Every element should be queued");
+
+    void *peeked;
+    ChunkedQueue__peek(queue, &peeked);
+    ASSERT_EQ(*(int *)peeked, 0, "Peek should return the head");
+
+    for (int i = 0; i < count; i++)
+    {
+        int value;
+        ChunkedQueue__dequeue(queue, &value);
+        ASSERT_EQ(value, i, "Value should match FIFO order");
+    }
+
+    ASSERT_EQ(queue->numberOfElements, 0, "ChunkedQueue should be empty");
+    ChunkedQueue__del(queue);
+}
+
+// Test: Emptied blocks are recycled through a bounded free list
+TEST(test_chunkedqueue_block_reuse)
+{
+    ChunkedQueue *queue = ChunkedQueue__new(sizeof(int));
+    int next = 0;
+    int expected = 0;
+
+    // Keep a backlog of two blocks so the head keeps retiring blocks
+    for (int round = 0; round < 20; round++)
+    {
+        for (int i = 0; i < CHUNKED_QUEUE_BLOCK_ELEMENTS; i++)
+        {
+            ChunkedQueue__enqueue(queue, &next);
+            next++;
+        }
+
+        while (queue->numberOfElements > CHUNKED_QUEUE_BLOCK_ELEMENTS * 2)
+        {
+            int value;
+            ChunkedQueue__dequeue(queue, &value);
+            ASSERT_EQ(value, expected++, "Value should match FIFO order");
+        }
+    }
+
+    ASSERT(queue->numberOfFreeBlocks <= 1, "Retired blocks should be reused by the tail");
+
+    while (queue->numberOfElements > 0)
+    {
+        int value;
+        ChunkedQueue__dequeue(queue, &value);
+        ASSERT_EQ(value, expected++, "Value should match FIFO order");
+    }
+
+    ASSERT_EQ(expected, next, "Every element should be dequeued");
+    ASSERT(queue->numberOfFreeBlocks <= CHUNKED_QUEUE_MAX_FREE_BLOCKS, "Free list should stay bounded");
+    ChunkedQueue__del(queue);
+}
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <cbarroso/countmin.h>
+#include <ccauchy.h>
+
+// Test: Create a new CountMinSketch
+TEST(test_countmin_new)
+{
+    CountMinSketch *sketch = CountMinSketch__new(0.001, 0.01, 1, 2);
+    ASSERT_NOT_NULL(sketch, "CountMinSketch should not be NULL");
+    ASSERT_EQ(sketch->width, 4096, "Width should be e / epsilon rounded to a power of two");
+    ASSERT_EQ(sketch->depth, 5, "Depth should be ln(1 / delta)");
+    ASSERT(CountMinSketch__new(0, 0.01, 1, 2) == NULL, "Invalid epsilon should be rejected");
+    ASSERT(CountMinSketch__new(1e-300, 0.01, 1, 2) == NULL, "Epsilon too small to allocate should be rejected");
+    CountMinSketch__del(sketch);
+}
+
+// Test: Estimates never undercount and find heavy hitters
+TEST(test_countmin_estimate)
+{
+    CountMinSketch *sketch = CountMinSketch__new(0.001, 0.01, 1, 2);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        CountMinSketch__add(sketch, &i, sizeof(int), 1);
+    }
+
+    int heavy = 7;
+    CountMinSketch__add(sketch, &heavy, sizeof(int), 5000);
+    ASSERT_EQ(sketch->total, 25000, "Total should count every addition");
+
+    for (int i = 0; i < 20000; i += 13)
+    {
+        uint64_t estimate = CountMinSketch__estimate(sketch, &i, sizeof(int));
+        uint64_t exact = i == heavy ? 5001 : 1;
+        ASSERT(estimate >= exact, "Estimate should never undercount");
+        ASSERT(estimate <= exact + 25, "Estimate should stay within epsilon * total");
+    }
+
+    ASSERT(CountMinSketch__estimate(sketch, &heavy, sizeof(int)) >= sketch->total / 10,
+           "Heavy hitter should be above 10% of the total");
+
+    CountMinSketch__del(sketch);
+}
+
+// Test: Merging adds the counters
+TEST(test_countmin_merge)
+{
+    CountMinSketch *left = CountMinSketch__new(0.01, 0.01, 3, 4);
+    CountMinSketch *right = CountMinSketch__new(0.01, 0.01, 3, 4);
+    CountMinSketch *other = CountMinSketch__new(0.001, 0.01, 3, 4);
+    const char *key = "key";
+
+    CountMinSketch__add(left, key, 3, 10);
+    CountMinSketch__add(right, key, 3, 32);
+
+    ASSERT_EQ(CountMinSketch__merge(left, other), -1, "Sketches of different sizes should not merge");
+    ASSERT_EQ(CountMinSketch__merge(left, right), 0, "Merge should succeed");
+    ASSERT_EQ(CountMinSketch__estimate(left, key, 3), 42, "Merged counts should add up");
+    ASSERT_EQ(left->total, 42, "Merged totals should add up");
+
+    CountMinSketch__del(other);
+    CountMinSketch__del(right);
+    CountMinSketch__del(left);
+}
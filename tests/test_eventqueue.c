@@ -0,0 +1,131 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cbarroso/eventqueue.h>
+#include <ccauchy.h>
+
+#define HANDOFF_MESSAGES 100000
+
+static void *sProducer(void *argument)
+{
+    for (int i = 0; i < HANDOFF_MESSAGES; i++)
+    {
+        EventQueue__enqueue(argument, &i);
+    }
+
+    return NULL;
+}
+
+// Test: Create a new EventQueue
+TEST(test_eventqueue_new)
+{
+    EventQueue *queue = EventQueue__new(sizeof(int));
+    ASSERT_NOT_NULL(queue, "EventQueue should not be NULL");
+    ASSERT(queue->eventFd >= 0, "EventQueue should own an eventfd");
+    EventQueue__del(queue);
+}
+
+// Test: Enqueues are coalesced into a single signal until drained
+TEST(test_eventqueue_coalescing)
+{
+    EventQueue *queue = EventQueue__new(sizeof(int));
+    uint64_t counter = 0;
+    int values[8];
+    size_t count = 0;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        EventQueue__enqueue(queue, &i);
+    }
+
+    ASSERT_EQ(read(queue->eventFd, &counter, sizeof(counter)), sizeof(counter), "Eventfd should be readable");
+    ASSERT_EQ(counter, 1, "Thousand enqueues should signal once");
+
+    EventQueue__drain(queue, values, 8, &count);
+    ASSERT_EQ(count, 8, "Partial drain should fill the buffer");
+    ASSERT_EQ(values[7], 7, "Elements should come out in FIFO order");
+
+    int more = 1000;
+    EventQueue__enqueue(queue, &more);
+    ASSERT(read(queue->eventFd, &counter, sizeof(counter)) < 0, "Non-empty queue should not signal again");
+
+    EventQueue__del(queue);
+}
+
+// Test: An epoll loop receives every message from another thread
+TEST(test_eventqueue_epoll)
+{
+    EventQueue *queue = EventQueue__new(sizeof(int));
+    int epollFd = epoll_create1(0);
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = queue};
+    pthread_t producer;
+    int values[256];
+    int expected = 0;
+    int ordered = 1;
+    int wakeups = 0;
+
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, queue->eventFd, &event);
+    pthread_create(&producer, NULL, sProducer, queue);
+
+    while (expected < HANDOFF_MESSAGES)
+    {
+        struct epoll_event ready;
+
+        if (epoll_wait(epollFd, &ready, 1, 1000) != 1)
+        {
+            break;
+        }
+
+        wakeups++;
+        size_t count = 0;
+        EventQueue__drain(ready.data.ptr, values, 256, &count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ordered &= values[i] == expected++;
+        }
+    }
+
+    pthread_join(producer, NULL);
+    ASSERT_EQ(expected, HANDOFF_MESSAGES, "Every message should be received");
+    ASSERT(ordered, "Messages should arrive in order");
+    ASSERT(wakeups < HANDOFF_MESSAGES, "Wake-ups should be coalesced");
+
+    close(epollFd);
+    EventQueue__del(queue);
+}
+
+// Test: The eventfd is not left readable once concurrent drains empty the queue
+TEST(test_eventqueue_concurrent_drain)
+{
+    for (int round = 0; round < 4; round++)
+    {
+        EventQueue *queue = EventQueue__new(sizeof(int));
+        pthread_t producer;
+        int values[64];
+        int received = 0;
+        uint64_t counter;
+
+        pthread_create(&producer, NULL, sProducer, queue);
+
+        while (received < HANDOFF_MESSAGES)
+        {
+            size_t count = 0;
+            EventQueue__drain(queue, values, 64, &count);
+
+            if (count == 0)
+            {
+                sched_yield();
+            }
+
+            received += (int)count;
+        }
+
+        pthread_join(producer, NULL);
+        ASSERT_EQ(queue->ring->numberOfElements, 0, "Every message should be drained");
+        ASSERT(read(queue->eventFd, &counter, sizeof(counter)) < 0, "Empty queue should leave the eventfd unreadable");
+        EventQueue__del(queue);
+    }
+}
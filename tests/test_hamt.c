@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <string.h>
+#include <cbarroso/hamt.h>
+#include <ccauchy.h>
+
+// Test: Create a new Hamt
+TEST(test_hamt_new)
+{
+    Hamt *hamt = Hamt__new();
+    ASSERT_NOT_NULL(hamt, "Hamt should not be NULL");
+    ASSERT_EQ(hamt->count, 0, "Hamt should be empty");
+    ASSERT(hamt->root == NULL, "Empty Hamt should have no root");
+    Hamt__del(hamt);
+}
+
+// Test: Writes return new versions and leave older ones untouched
+TEST(test_hamt_persistence)
+{
+    Hamt *versions[201];
+    versions[0] = Hamt__new();
+
+    for (int i = 0; i < 200; i++)
+    {
+        int value = i * 10;
+        versions[i + 1] = Hamt__set(versions[i], &i, sizeof(int), &value, sizeof(int));
+        ASSERT_NOT_NULL(versions[i + 1], "Set should return a new version");
+    }
+
+    ASSERT_EQ(versions[200]->count, 200, "Latest version should hold every key");
+
+    for (int v = 0; v <= 200; v += 50)
+    {
+        ASSERT_EQ(versions[v]->count, (size_t)v, "Older versions should keep their count");
+
+        for (int i = 0; i < 200; i++)
+        {
+            void *value = NULL;
+            Hamt__get(versions[v], &i, sizeof(int), &value);
+
+            if (i < v)
+            {
+                ASSERT_NOT_NULL(value, "Key should be visible in later versions");
+                ASSERT_EQ(*(int *)value, i * 10, "Value should match");
+            }
+            else
+            {
+                ASSERT(value == NULL, "Key should not leak into earlier versions");
+            }
+        }
+    }
+
+    int key = 7;
+    int updated = -1;
+    Hamt *overwritten = Hamt__set(versions[200], &key, sizeof(int), &updated, sizeof(int));
+    void *value = NULL;
+    ASSERT_EQ(overwritten->count, 200, "Overwriting should not change the count");
+    Hamt__get(overwritten, &key, sizeof(int), &value);
+    ASSERT_EQ(*(int *)value, -1, "New version should see the new value");
+    Hamt__get(versions[200], &key, sizeof(int), &value);
+    ASSERT_EQ(*(int *)value, 70, "Old version should keep the old value");
+
+    // Releasing versions in any order keeps the shared nodes alive
+    for (int v = 0; v <= 200; v += 2)
+    {
+        Hamt__del(versions[v]);
+    }
+
+    Hamt__get(overwritten, &key, sizeof(int), &value);
+    ASSERT_EQ(*(int *)value, -1, "Shared nodes should survive older versions");
+
+    for (int v = 1; v <= 200; v += 2)
+    {
+        Hamt__del(versions[v]);
+    }
+
+    Hamt__del(overwritten);
+}
+
+// Test: Removing keys, including absent ones
+TEST(test_hamt_remove)
+{
+    Hamt *hamt = Hamt__new();
+
+    for (int i = 0; i < 100; i++)
+    {
+        Hamt *next = Hamt__set(hamt, &i, sizeof(int), &i, sizeof(int));
+        Hamt__del(hamt);
+        hamt = next;
+    }
+
+    Hamt *snapshot = Hamt__snapshot(hamt);
+    ASSERT(snapshot == hamt, "Snapshot should share the version");
+
+    int missing = 1000;
+    Hamt *same = Hamt__remove(hamt, &missing, sizeof(int));
+    ASSERT_EQ(same->count, 100, "Removing an absent key should keep the count");
+    ASSERT(same->root == hamt->root, "Removing an absent key should share the tree");
+    Hamt__del(same);
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        Hamt *next = Hamt__remove(hamt, &i, sizeof(int));
+        Hamt__del(hamt);
+        hamt = next;
+    }
+
+    ASSERT_EQ(hamt->count, 50, "Half of the keys should remain");
+    ASSERT_EQ(snapshot->count, 100, "Snapshot should keep every key");
+
+    for (int i = 0; i < 100; i++)
+    {
+        void *value = NULL;
+        Hamt__get(hamt, &i, sizeof(int), &value);
+        ASSERT((value != NULL) == (i % 2 == 1), "Only odd keys should remain");
+        Hamt__get(snapshot, &i, sizeof(int), &value);
+        ASSERT_NOT_NULL(value, "Snapshot should still see the key");
+    }
+
+    for (int i = 1; i < 100; i += 2)
+    {
+        Hamt *next = Hamt__remove(hamt, &i, sizeof(int));
+        Hamt__del(hamt);
+        hamt = next;
+    }
+
+    ASSERT_EQ(hamt->count, 0, "Every key should be removed");
+    ASSERT(hamt->root == NULL, "Empty version should have no root");
+    Hamt__del(hamt);
+    Hamt__del(snapshot);
+}
+
+// Test: Keys whose whole hash collides
+TEST(test_hamt_collisions)
+{
+    Hamt *hamt = Hamt__new();
+    const char *keys[] = {"alpha", "beta", "gamma"};
+    hash_t hash = 0x2a;
+
+    for (int i = 0; i < 3; i++)
+    {
+        Hamt *next = Hamt__setHashed(hamt, (void *)keys[i], strlen(keys[i]) + 1, hash, &i, sizeof(int));
+        Hamt__del(hamt);
+        hamt = next;
+    }
+
+    // A key sharing the low fragments only, which must split below the collision
+    int other = 3;
+    Hamt *next = Hamt__setHashed(hamt, "delta", 6, hash | ((hash_t)1 << 40), &other, sizeof(int));
+    Hamt__del(hamt);
+    hamt = next;
+
+    ASSERT_EQ(hamt->count, 4, "Colliding keys should all be stored");
+
+    for (int i = 0; i < 3; i++)
+    {
+        void *value = NULL;
+        Hamt__getHashed(hamt, (void *)keys[i], strlen(keys[i]) + 1, hash, &value);
+        ASSERT_NOT_NULL(value, "Colliding key should be found");
+        ASSERT_EQ(*(int *)value, i, "Colliding key should keep its own value");
+    }
+
+    next = Hamt__removeHashed(hamt, "beta", 5, hash);
+    Hamt__del(hamt);
+    hamt = next;
+    next = Hamt__removeHashed(hamt, "alpha", 6, hash);
+    Hamt__del(hamt);
+    hamt = next;
+
+    void *value = NULL;
+    ASSERT_EQ(hamt->count, 2, "Two keys should remain");
+    Hamt__getHashed(hamt, "gamma", 6, hash, &value);
+    ASSERT_EQ(*(int *)value, 2, "Last colliding key should survive the collapse");
+    Hamt__getHashed(hamt, "delta", 6, hash | ((hash_t)1 << 40), &value);
+    ASSERT_EQ(*(int *)value, 3, "Neighbouring key should be unaffected");
+    Hamt__getHashed(hamt, "alpha", 6, hash, &value);
+    ASSERT(value == NULL, "Removed colliding key should be gone");
+
+    Hamt__del(hamt);
+}
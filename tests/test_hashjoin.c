@@ -0,0 +1,112 @@
+#include <cbarroso/hashjoin.h>
+#include <ccauchy.h>
+
+// Test: Create a new HashJoin
+TEST(test_hashjoin_new)
+{
+    HashJoin *join = HashJoin__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(join, "HashJoin should not be NULL");
+    ASSERT_EQ(join->numberOfRows, 0, "HashJoin should be empty");
+    HashJoin__del(join);
+}
+
+// Test: Duplicate build keys are all matched
+TEST(test_hashjoin_duplicate_keys)
+{
+    HashJoin *join = HashJoin__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(join, "HashJoin should not be NULL");
+
+    // Build rows 0..29 with keys 0..9, three rows per key
+    for (size_t row = 0; row < 30; row++)
+    {
+        int key = (int)(row % 10);
+        int8_t result = HashJoin__build(join, &key, sizeof(int), row);
+        ASSERT_EQ(result, 0, "build should succeed");
+    }
+
+    ASSERT_EQ(join->heads->nitems, 10, "There should be one head per distinct key");
+
+    int probeKeys[4] = {3, 42, 7, 3};
+    void *keys[4];
+    size_t keySizes[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+        keys[i] = &probeKeys[i];
+        keySizes[i] = sizeof(int);
+    }
+
+    HashJoinMatch matches[32];
+    HashJoinCursor cursor;
+    HashJoinCursor__reset(&cursor);
+    size_t count = HashJoin__probeBatch(join, keys, keySizes, 4, matches, 32, &cursor);
+
+    ASSERT_EQ(count, 9, "Each matching probe key should pair with three rows");
+    ASSERT_EQ(cursor.position, 4, "The whole batch should be consumed");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT((int)(matches[i].buildRow % 10) == probeKeys[matches[i].probeRow],
+               "Matched rows should share the key");
+        ASSERT(matches[i].probeRow != 1, "Unknown keys should not match");
+    }
+
+    HashJoin__del(join);
+}
+
+// Test: Probing resumes when the output buffer is full
+TEST(test_hashjoin_resume)
+{
+    HashJoin *join = HashJoin__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(join, "HashJoin should not be NULL");
+
+    for (size_t row = 0; row < 100; row++)
+    {
+        int key = (int)(row % 5);
+        HashJoin__build(join, &key, sizeof(int), row);
+    }
+
+    int probeKeys[40];
+    void *keys[40];
+    size_t keySizes[40];
+
+    for (int i = 0; i < 40; i++)
+    {
+        probeKeys[i] = i % 8;
+        keys[i] = &probeKeys[i];
+        keySizes[i] = sizeof(int);
+    }
+
+    int pairs[40][100] = {{0}};
+    HashJoinMatch matches[7];
+    HashJoinCursor cursor;
+    HashJoinCursor__reset(&cursor);
+    size_t total = 0;
+
+    while (cursor.position < 40)
+    {
+        size_t count = HashJoin__probeBatch(join, keys, keySizes, 40, matches, 7, &cursor);
+        ASSERT(count <= 7, "Output should respect the buffer capacity");
+
+        for (size_t i = 0; i < count; i++)
+        {
+            pairs[matches[i].probeRow][matches[i].buildRow]++;
+        }
+
+        total += count;
+    }
+
+    // Probe keys 0..4 match 20 rows each, 5..7 none
+    ASSERT_EQ(total, 25 * 20, "Every pair should be emitted");
+
+    for (int probe = 0; probe < 40; probe++)
+    {
+        for (int row = 0; row < 100; row++)
+        {
+            int expected = (probeKeys[probe] == row % 5) ? 1 : 0;
+            ASSERT_EQ(pairs[probe][row], expected, "Each pair should be emitted exactly once");
+        }
+    }
+
+    HashJoin__del(join);
+}
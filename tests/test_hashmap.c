@@ -506,3 +506,584 @@ TEST(test_hashmap_pointer_key)
 
     free(map);
 }
+
+// Test: Setting an existing key replaces its value
+TEST(test_hashmap_set_existing_key)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    char *key = "counter";
+    int value1 = 10;
+    int value2 = 20;
+
+    HashMap__setItem(map, key, strlen(key) + 1, &value1, sizeof(int));
+    HashMap__setItem(map, key, strlen(key) + 1, &value2, sizeof(int));
+    ASSERT_EQ(map->nentries, 1, "Updating a key should not add an entry");
+
+    void *retrieved = NULL;
+    HashMap__getItem(map, key, strlen(key) + 1, &retrieved);
+    ASSERT_NOT_NULL(retrieved, "Retrieved value should not be NULL");
+    ASSERT_EQ(*(int *)retrieved, value2, "Retrieved value should be the latest one");
+
+    HashMap__del(map);
+}
+
+// Test: Insertions past the usable capacity resize the map
+TEST(test_hashmap_resize)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    for (int i = 0; i < 1000; i++)
+    {
+        int8_t result = HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+        ASSERT_EQ(result, 0, "setItem should succeed while resizing");
+    }
+
+    ASSERT_EQ(map->nentries, 1000, "nentries should be 1000");
+    ASSERT(map->log2_size > LOG2_MINSIZE, "Map should have grown");
+
+    for (int i = 0; i < 1000; i++)
+    {
+        void *retrieved = NULL;
+        HashMap__getItem(map, &i, sizeof(int), &retrieved);
+        ASSERT_NOT_NULL(retrieved, "Every key should survive the resizes");
+        ASSERT_EQ(*(int *)retrieved, i, "Retrieved value should match");
+    }
+
+    HashMap__del(map);
+}
+
+// Test: Iterator yields entries in insertion order across resizes
+TEST(test_hashmap_iterator)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    HashMapIterator iterator;
+    HashMapEntry *entry = NULL;
+    HashMap__iter(map, &iterator);
+    ASSERT_EQ(HashMapIterator__next(&iterator, &entry), 0, "Empty map should yield nothing");
+
+    for (int i = 0; i < 3; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    HashMap__iter(map, &iterator);
+    int expected = 0;
+
+    while (HashMapIterator__next(&iterator, &entry))
+    {
+        ASSERT_EQ(*(int *)entry->key, expected, "Entries should come in insertion order");
+        expected++;
+
+        // Grow the map while iterating
+        if (expected == 2)
+        {
+            for (int i = 3; i < 100; i++)
+            {
+                HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+            }
+        }
+    }
+
+    ASSERT_EQ(expected, 100, "Iterator should visit entries added during iteration");
+
+    HashMap__del(map);
+}
+
+// Test: Cursor scan visits every entry once across resizes
+TEST(test_hashmap_scan)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    for (int i = 0; i < 50; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    int seen[200] = {0};
+    HashMapEntry *batch[7];
+    size_t count = 0;
+    size_t cursor = 0;
+    int nextKey = 50;
+
+    do
+    {
+        cursor = HashMap__scan(map, cursor, batch, 7, &count);
+        ASSERT(count <= 7, "Scan should respect the batch capacity");
+
+        for (size_t i = 0; i < count; i++)
+        {
+            seen[*(int *)batch[i]->key]++;
+        }
+
+        // Keep writing between slices
+        for (int i = 0; i < 10 && nextKey < 200; i++, nextKey++)
+        {
+            HashMap__setItem(map, &nextKey, sizeof(int), &nextKey, sizeof(int));
+        }
+    } while (cursor != 0);
+
+    for (int i = 0; i < 200; i++)
+    {
+        ASSERT(seen[i] <= 1, "No entry should be returned twice");
+    }
+
+    for (int i = 0; i < 50; i++)
+    {
+        ASSERT_EQ(seen[i], 1, "Entries present for the whole scan should be returned");
+    }
+
+    HashMap__del(map);
+}
+
+// Test: Load and memory diagnostics
+TEST(test_hashmap_stats)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    for (int i = 0; i < 4; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    HashMapStats stats;
+    int8_t result = HashMap__stats(map, &stats, 1);
+    ASSERT_EQ(result, 0, "stats should succeed");
+    ASSERT_EQ(stats.size, 8, "Index should have 8 slots");
+    ASSERT_EQ(stats.nitems, 4, "Map should hold 4 items");
+    ASSERT(stats.loadFactor == 0.5, "Load factor should be 4 / 8");
+    ASSERT_EQ(stats.deadSlots, 0, "No slot should be dead");
+    ASSERT_EQ(stats.indexBytes, 1, "Small maps should use 8-bit indices");
+    ASSERT_EQ(stats.indicesBytes, 8, "Indices should take one byte per slot");
+    ASSERT_EQ(stats.payloadBytes, 8 * sizeof(int), "Payload should count keys and values");
+    ASSERT_EQ(stats.sampledEntries, 4, "Every entry should be sampled");
+
+    size_t histogramTotal = 0;
+
+    for (int i = 0; i < HASHMAP_PROBE_HISTOGRAM_SIZE; i++)
+    {
+        histogramTotal += stats.probeHistogram[i];
+    }
+
+    ASSERT_EQ(histogramTotal, 4, "Histogram should count every sampled entry");
+
+    for (int i = 4; i < 300; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    HashMap__stats(map, &stats, 0);
+    ASSERT_EQ(stats.indexBytes, 2, "Larger maps should use 16-bit indices");
+    ASSERT_EQ(stats.sampledEntries, 0, "Sampling should be skippable");
+#ifdef CBR_HASHMAP_COUNTERS
+    ASSERT(stats.resizes > 0, "Resizes should be counted");
+    ASSERT(stats.probes > 0, "Probes should be counted");
+#endif
+
+    HashMap__del(map);
+}
+
+// Test: Removing keys
+TEST(test_hashmap_del_item)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    for (int i = 0; i < 100; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        int8_t result = HashMap__delItem(map, &i, sizeof(int));
+        ASSERT_EQ(result, 0, "delItem should succeed for present keys");
+    }
+
+    int missing = 0;
+    ASSERT_EQ(HashMap__delItem(map, &missing, sizeof(int)), -1, "delItem should fail for absent keys");
+    ASSERT_EQ(map->nitems, 50, "Half of the keys should be left");
+
+    HashMapStats stats;
+    HashMap__stats(map, &stats, 0);
+    ASSERT_EQ(stats.deadSlots, 50, "Removed keys should leave dead slots");
+
+    // Reinsert enough keys to force resizes that drop the removed entries
+    for (int i = 100; i < 300; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    for (int i = 0; i < 300; i++)
+    {
+        void *retrieved = NULL;
+        HashMap__getItem(map, &i, sizeof(int), &retrieved);
+
+        if (i < 100 && i % 2 == 0)
+        {
+            ASSERT(retrieved == NULL, "Removed keys should not be found");
+        }
+        else
+        {
+            ASSERT_NOT_NULL(retrieved, "Remaining keys should be found");
+            ASSERT_EQ(*(int *)retrieved, i, "Retrieved value should match");
+        }
+    }
+
+    HashMapIterator iterator;
+    HashMapEntry *entry = NULL;
+    int previous = -1;
+    int count = 0;
+    HashMap__iter(map, &iterator);
+
+    while (HashMapIterator__next(&iterator, &entry))
+    {
+        ASSERT(*(int *)entry->key > previous, "Iteration should keep insertion order");
+        previous = *(int *)entry->key;
+        count++;
+    }
+
+    ASSERT_EQ(count, 250, "Iteration should skip removed keys");
+
+    HashMap__del(map);
+}
+
+// Test: Cursor scan keeps its place when a resize drops removed entries
+TEST(test_hashmap_scan_with_removals)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    for (int i = 0; i < 40; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    int seen[40] = {0};
+    HashMapEntry *batch[5];
+    size_t count = 0;
+    size_t cursor = HashMap__scan(map, 0, batch, 5, &count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        seen[*(int *)batch[i]->key]++;
+    }
+
+    // Remove keys behind and ahead of the cursor, then force a resize
+    for (int i = 0; i < 40; i += 3)
+    {
+        HashMap__delItem(map, &i, sizeof(int));
+    }
+
+    for (int i = 1000; i < 1100; i++)
+    {
+        HashMap__setItem(map, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    while (cursor != 0)
+    {
+        cursor = HashMap__scan(map, cursor, batch, 5, &count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            int key = *(int *)batch[i]->key;
+
+            if (key < 40)
+            {
+                seen[key]++;
+            }
+        }
+    }
+
+    for (int i = 0; i < 40; i++)
+    {
+        ASSERT(seen[i] <= 1, "No entry should be returned twice");
+
+        if (i % 3 != 0)
+        {
+            ASSERT_EQ(seen[i], 1, "Entries kept during the scan should be returned");
+        }
+    }
+
+    HashMap__del(map);
+}
+
+// Test: Content digest is order-independent and tracks updates
+TEST(test_hashmap_digest)
+{
+    HashMap *map1 = HashMap__new(LOG2_MINSIZE);
+    HashMap *map2 = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map1, "HashMap should not be NULL");
+    ASSERT_NOT_NULL(map2, "HashMap should not be NULL");
+
+    ASSERT_EQ(HashMap__enableDigest(map1, 1, 2, 4), 0, "enableDigest should succeed");
+
+    for (int i = 0; i < 100; i++)
+    {
+        int value = i * 7;
+        HashMap__setItem(map1, &i, sizeof(int), &value, sizeof(int));
+    }
+
+    for (int i = 99; i >= 0; i--)
+    {
+        int value = i * 7;
+        HashMap__setItem(map2, &i, sizeof(int), &value, sizeof(int));
+    }
+
+    // Enabling after the inserts should reach the same digest
+    ASSERT_EQ(HashMap__enableDigest(map2, 1, 2, 4), 0, "enableDigest should succeed");
+    ASSERT(HashMap__getDigest(map1) != 0, "Digest should not be empty");
+    ASSERT(HashMap__getDigest(map1) == HashMap__getDigest(map2), "Same content should give the same digest");
+
+    int key = 42;
+    int newValue = -1;
+    HashMap__setItem(map2, &key, sizeof(int), &newValue, sizeof(int));
+    ASSERT(HashMap__getDigest(map1) != HashMap__getDigest(map2), "Updating a value should change the digest");
+
+    size_t nbuckets1 = 0;
+    size_t nbuckets2 = 0;
+    const uint64_t *buckets1 = HashMap__getDigestBuckets(map1, &nbuckets1);
+    const uint64_t *buckets2 = HashMap__getDigestBuckets(map2, &nbuckets2);
+    ASSERT_EQ(nbuckets1, 16, "There should be 16 buckets");
+    ASSERT_EQ(nbuckets2, 16, "There should be 16 buckets");
+
+    size_t ndiffering = 0;
+    size_t differingBucket = 0;
+
+    for (size_t i = 0; i < nbuckets1; i++)
+    {
+        if (buckets1[i] != buckets2[i])
+        {
+            ndiffering++;
+            differingBucket = i;
+        }
+    }
+
+    ASSERT_EQ(ndiffering, 1, "Only the bucket of the updated key should differ");
+
+    HashMapEntry *entries[100];
+    size_t count = HashMap__getDigestBucketEntries(map2, differingBucket, entries, 100);
+    int found = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        found |= *(int *)entries[i]->key == key;
+    }
+
+    ASSERT(found, "The differing bucket should hold the updated key");
+
+    HashMap__delItem(map2, &key, sizeof(int));
+    size_t countAfterRemoval = HashMap__getDigestBucketEntries(map2, differingBucket, entries, 100);
+    ASSERT_EQ(countAfterRemoval, count - 1, "Removing the key should leave its bucket");
+
+    int oldValue = key * 7;
+    HashMap__setItem(map2, &key, sizeof(int), &oldValue, sizeof(int));
+    ASSERT(HashMap__getDigest(map1) == HashMap__getDigest(map2), "Restoring the value should restore the digest");
+
+    HashMap__del(map1);
+    HashMap__del(map2);
+}
+
+static void sMergeMax(void *value, const void *delta, size_t valueSize, void *context)
+{
+    (void)valueSize;
+    int *calls = context;
+    (*calls)++;
+
+    if (*(const int *)delta > *(int *)value)
+    {
+        *(int *)value = *(const int *)delta;
+    }
+}
+
+// Test: In-place counters and aggregations
+TEST(test_hashmap_aggregation)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    char *key = "hits";
+    int64_t count = 0;
+
+    for (int i = 1; i <= 10; i++)
+    {
+        int8_t result = HashMap__addInt64(map, key, strlen(key) + 1, i, &count);
+        ASSERT_EQ(result, 0, "addInt64 should succeed");
+    }
+
+    ASSERT_EQ(count, 55, "Counter should hold the sum of the deltas");
+    ASSERT_EQ(map->nentries, 1, "Counting should not append entries");
+    ASSERT(HashMap__getEntries(map)[0]->value == &HashMap__getEntries(map)[0]->inlineValue,
+           "Counters should be stored inside the entry");
+
+    double sum = 0;
+    HashMap__addDouble(map, "total", 6, 1.5, NULL);
+    HashMap__addDouble(map, "total", 6, 2.25, &sum);
+    ASSERT(sum == 3.75, "Double sum should be 3.75");
+
+    int calls = 0;
+    int small = 1;
+    ASSERT_EQ(HashMap__mergeWith(map, key, strlen(key) + 1, &small, sizeof(int), sMergeMax, &calls, NULL),
+              -1,
+              "Merging a value of another size should fail");
+
+    int values[] = {3, 9, 4};
+    void *stored = NULL;
+
+    for (int i = 0; i < 3; i++)
+    {
+        HashMap__mergeWith(map, "max", 4, &values[i], sizeof(int), sMergeMax, &calls, &stored);
+    }
+
+    ASSERT_EQ(*(int *)stored, 9, "Merge function should keep the maximum");
+    ASSERT_EQ(calls, 2, "First value should be stored without merging");
+
+    HashMap__del(map);
+}
+
+// Test: Batch counters
+TEST(test_hashmap_aggregation_batch)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    int keyValues[100];
+    void *keys[100];
+    size_t keySizes[100];
+    int64_t deltas[100];
+
+    for (int i = 0; i < 100; i++)
+    {
+        keyValues[i] = i % 7;
+        keys[i] = &keyValues[i];
+        keySizes[i] = sizeof(int);
+        deltas[i] = i;
+    }
+
+    int8_t result = HashMap__addInt64Batch(map, keys, keySizes, deltas, 100);
+    ASSERT_EQ(result, 0, "addInt64Batch should succeed");
+    ASSERT_EQ(map->nitems, 7, "There should be one counter per distinct key");
+
+    for (int key = 0; key < 7; key++)
+    {
+        int64_t expected = 0;
+
+        for (int i = key; i < 100; i += 7)
+        {
+            expected += i;
+        }
+
+        void *retrieved = NULL;
+        HashMap__getItem(map, &key, sizeof(int), &retrieved);
+        ASSERT_NOT_NULL(retrieved, "Counter should exist");
+        ASSERT_EQ(*(int64_t *)retrieved, expected, "Counter should hold the sum of its deltas");
+    }
+
+    HashMap__del(map);
+}
+
+// Test: Keys with a time to live expire when the clock advances
+TEST(test_hashmap_ttl)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    ASSERT_NOT_NULL(map, "HashMap should not be NULL");
+
+    for (int i = 0; i < 100; i++)
+    {
+        int8_t result = HashMap__setItemTTL(map, &i, sizeof(int), &i, sizeof(int), 10 + i);
+        ASSERT_EQ(result, 0, "setItemTTL should succeed");
+    }
+
+    int permanent = 1000;
+    HashMap__setItem(map, &permanent, sizeof(int), &permanent, sizeof(int));
+
+    // Setting without a TTL makes a key permanent again
+    int key = 0;
+    HashMap__setItem(map, &key, sizeof(int), &key, sizeof(int));
+
+    size_t expired = HashMap__advanceClock(map, 59, SIZE_MAX);
+    ASSERT_EQ(expired, 49, "Keys 1..49 should expire by tick 59");
+    ASSERT_EQ(map->nitems, 52, "Permanent and later keys should remain");
+
+    void *retrieved = NULL;
+    HashMap__getItem(map, &key, sizeof(int), &retrieved);
+    ASSERT_NOT_NULL(retrieved, "Key set without TTL should not expire");
+
+    key = 49;
+    HashMap__getItem(map, &key, sizeof(int), &retrieved);
+    ASSERT(retrieved == NULL, "Expired key should be gone");
+
+    key = 50;
+    HashMap__getItem(map, &key, sizeof(int), &retrieved);
+    ASSERT_NOT_NULL(retrieved, "Key 50 should still be alive");
+
+    // With no budget, lookups still hide keys past their deadline
+    expired = HashMap__advanceClock(map, 70, 0);
+    ASSERT_EQ(expired, 0, "No key should be reaped without budget");
+    HashMap__getItem(map, &key, sizeof(int), &retrieved);
+    ASSERT(retrieved == NULL, "Lookup should expire a key past its deadline");
+
+    // Keys 51..60 are past their deadline but not reaped yet
+    HashMapIterator iterator;
+    HashMapEntry *entry;
+    size_t iterated = 0;
+    HashMap__iter(map, &iterator);
+
+    while (HashMapIterator__next(&iterator, &entry))
+    {
+        iterated++;
+    }
+
+    ASSERT_EQ(iterated, 41, "Iteration should skip keys past their deadline");
+
+    HashMapEntry *scanned[128];
+    size_t scannedCount = 0;
+    HashMap__scan(map, 0, scanned, 128, &scannedCount);
+    ASSERT_EQ(scannedCount, 41, "Scan should skip keys past their deadline");
+
+    HashMapStats stats;
+    HashMap__stats(map, &stats, 0);
+    ASSERT_EQ(stats.nitems, 41, "Stats should not count keys past their deadline");
+
+    expired = HashMap__advanceClock(map, 1000, SIZE_MAX);
+    ASSERT_EQ(expired, 49, "The remaining keys with a TTL should expire");
+    ASSERT_EQ(map->nitems, 2, "Only the permanent keys should remain");
+
+    // A deadline past the end of the clock saturates instead of wrapping
+    key = 2000;
+    HashMap__setItemTTL(map, &key, sizeof(int), &key, sizeof(int), UINT64_MAX);
+    HashMap__advanceClock(map, UINT64_MAX - 1, SIZE_MAX);
+    HashMap__getItem(map, &key, sizeof(int), &retrieved);
+    ASSERT_NOT_NULL(retrieved, "Saturated TTL should not expire early");
+
+    HashMap__del(map);
+}
+
+// Test: Reserved values are zeroed and filled in place
+TEST(test_hashmap_reserve)
+{
+    HashMap *map = HashMap__new(LOG2_MINSIZE);
+    HashMapEntry *entry = NULL;
+    int key = 7;
+
+    ASSERT_EQ(HashMap__reserveItem(map, &key, sizeof(int), 2 * sizeof(int), &entry), 0, "Reserve should succeed");
+    ASSERT_NOT_NULL(entry, "Reserve should return the entry");
+    ASSERT_EQ(((int *)entry->value)[1], 0, "Reserved value should be zeroed");
+
+    ((int *)entry->value)[1] = 42;
+
+    void *retrieved = NULL;
+    HashMap__getItem(map, &key, sizeof(int), &retrieved);
+    ASSERT(retrieved == entry->value, "Lookup should return the reserved value");
+    ASSERT_EQ(((int *)retrieved)[1], 42, "Value should be filled in place");
+    ASSERT_EQ(HashMap__reserveItem(map, &key, sizeof(int), sizeof(int), &entry), -1,
+              "Reserving a present key should fail");
+
+    HashMap__del(map);
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <cbarroso/hashring.h>
+#include <ccauchy.h>
+
+// Test: Create a new HashRing
+TEST(test_hashring_new)
+{
+    HashRing *ring = HashRing__new(100, 1, 2);
+    ASSERT_NOT_NULL(ring, "HashRing should not be NULL");
+    ASSERT_EQ(ring->numberOfPoints, 0, "HashRing should be empty");
+
+    uint32_t node = 0;
+    int key = 1;
+    ASSERT_EQ(HashRing__getNode(ring, &key, sizeof(int), &node), -1, "Empty ring should not map keys");
+
+    HashRing__del(ring);
+}
+
+// Test: Weighted nodes get a proportional share of keys
+TEST(test_hashring_weights)
+{
+    HashRing *ring = HashRing__new(200, 1, 2);
+    int counts[3] = {0, 0, 0};
+
+    HashRing__addNode(ring, 0, 1);
+    HashRing__addNode(ring, 1, 1);
+    HashRing__addNode(ring, 2, 2);
+    ASSERT_EQ(HashRing__addNode(ring, 2, 1), -1, "Node should not be added twice");
+    ASSERT_EQ(ring->numberOfPoints, 800, "Points should follow the weights");
+
+    for (int i = 0; i < 40000; i++)
+    {
+        uint32_t node = 0;
+        HashRing__getNode(ring, &i, sizeof(int), &node);
+        counts[node]++;
+    }
+
+    ASSERT(counts[0] > 8000 && counts[0] < 12000, "Unit weight node should get about a quarter");
+    ASSERT(counts[1] > 8000 && counts[1] < 12000, "Unit weight node should get about a quarter");
+    ASSERT(counts[2] > 16000 && counts[2] < 24000, "Double weight node should get about half");
+
+    HashRing__del(ring);
+}
+
+// Test: Adding and removing a node only moves its own keys
+TEST(test_hashring_rebalance)
+{
+    HashRing *ring = HashRing__new(100, 3, 4);
+    int keys[10000];
+    void *keyAddrs[10000];
+    size_t keySizes[10000];
+    uint32_t before[10000];
+    uint32_t after[10000];
+
+    for (int i = 0; i < 10000; i++)
+    {
+        keys[i] = i;
+        keyAddrs[i] = &keys[i];
+        keySizes[i] = sizeof(int);
+    }
+
+    for (uint32_t node = 0; node < 4; node++)
+    {
+        HashRing__addNode(ring, node, 1);
+    }
+
+    HashRing__getNodeBatch(ring, keyAddrs, keySizes, 10000, before);
+    HashRing__addNode(ring, 4, 1);
+    HashRing__getNodeBatch(ring, keyAddrs, keySizes, 10000, after);
+
+    int moved = 0;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT(after[i] == before[i] || after[i] == 4, "Keys should only move to the new node");
+        moved += after[i] != before[i];
+    }
+
+    ASSERT(moved > 1000 && moved < 3000, "About a fifth of the keys should move");
+
+    HashRing__removeNode(ring, 4);
+    HashRing__getNodeBatch(ring, keyAddrs, keySizes, 10000, after);
+
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT_EQ(after[i], before[i], "Removing the node should restore the mapping");
+    }
+
+    ASSERT_EQ(HashRing__removeNode(ring, 4), -1, "Unknown node should not be removed");
+
+    HashRing__del(ring);
+}
+
+// Test: Jump consistent hash moves about 1/n of the keys
+TEST(test_hashring_jump)
+{
+    int moved = 0;
+
+    ASSERT_EQ(jumpConsistentHash(42, 0), -1, "No buckets should map to -1");
+    ASSERT_EQ(jumpConsistentHash(42, 1), 0, "Single bucket should take every key");
+
+    for (uint64_t key = 0; key < 10000; key++)
+    {
+        hash_t hash = hashBuffer(&key, sizeof(key));
+        int32_t before = jumpConsistentHash(hash, 10);
+        int32_t after = jumpConsistentHash(hash, 11);
+
+        ASSERT(before >= 0 && before < 10, "Bucket should be in range");
+        ASSERT(after == before || after == 10, "Keys should only move to the new bucket");
+        moved += after != before;
+    }
+
+    ASSERT(moved > 600 && moved < 1200, "About an eleventh of the keys should move");
+}
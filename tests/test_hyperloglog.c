@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <cbarroso/hyperloglog.h>
+#include <ccauchy.h>
+
+// Test: Create a new HyperLogLog
+TEST(test_hyperloglog_new)
+{
+    HyperLogLog *hll = HyperLogLog__new(12, 1, 2);
+    ASSERT_NOT_NULL(hll, "HyperLogLog should not be NULL");
+    ASSERT(HyperLogLog__estimate(hll) == 0.0, "Empty sketch should estimate zero");
+    ASSERT(HyperLogLog__new(2, 1, 2) == NULL, "Out of range precision should be rejected");
+    HyperLogLog__del(hll);
+}
+
+// Test: Estimates stay within a few standard errors, duplicates are ignored
+TEST(test_hyperloglog_estimate)
+{
+    HyperLogLog *hll = HyperLogLog__new(12, 1, 2);
+
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < 100000; i++)
+        {
+            HyperLogLog__add(hll, &i, sizeof(int));
+        }
+    }
+
+    double estimate = HyperLogLog__estimate(hll);
+    ASSERT(estimate > 95000 && estimate < 105000, "Large cardinality should be within 5%");
+
+    HyperLogLog *small = HyperLogLog__new(12, 1, 2);
+
+    for (int i = 0; i < 100; i++)
+    {
+        HyperLogLog__add(small, &i, sizeof(int));
+    }
+
+    estimate = HyperLogLog__estimate(small);
+    ASSERT(estimate > 97 && estimate < 103, "Small cardinality should use linear counting");
+
+    HyperLogLog__del(small);
+    HyperLogLog__del(hll);
+}
+
+// Test: Merging estimates the union
+TEST(test_hyperloglog_merge)
+{
+    HyperLogLog *left = HyperLogLog__new(14, 3, 4);
+    HyperLogLog *right = HyperLogLog__new(14, 3, 4);
+    HyperLogLog *other = HyperLogLog__new(14, 5, 6);
+
+    for (int i = 0; i < 60000; i++)
+    {
+        HyperLogLog__add(left, &i, sizeof(int));
+    }
+
+    for (int i = 40000; i < 100000; i++)
+    {
+        HyperLogLog__add(right, &i, sizeof(int));
+    }
+
+    ASSERT_EQ(HyperLogLog__merge(left, other), -1, "Sketches with different keys should not merge");
+    ASSERT_EQ(HyperLogLog__merge(left, right), 0, "Merge should succeed");
+
+    double estimate = HyperLogLog__estimate(left);
+    ASSERT(estimate > 97000 && estimate < 103000, "Merged sketch should estimate the union");
+
+    HyperLogLog__del(other);
+    HyperLogLog__del(right);
+    HyperLogLog__del(left);
+}
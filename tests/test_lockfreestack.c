@@ -0,0 +1,103 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <cbarroso/lockfreestack.h>
+#include <ccauchy.h>
+
+#define STRESS_THREADS 4
+#define STRESS_ITERATIONS 20000
+
+typedef struct StressContext
+{
+    LockFreeStack *stack;
+    int thread;
+    long long popped;
+} StressContext;
+
+static void *sStressWorker(void *argument)
+{
+    StressContext *context = argument;
+
+    for (int i = 0; i < STRESS_ITERATIONS; i++)
+    {
+        long long value = (long long)context->thread * STRESS_ITERATIONS + i;
+
+        while (LockFreeStack__push(context->stack, &value) != 0)
+        {
+        }
+
+        if (LockFreeStack__pop(context->stack, &value) == 0)
+        {
+            context->popped += value;
+        }
+    }
+
+    return NULL;
+}
+
+// Test: Create a new LockFreeStack
+TEST(test_lockfreestack_new)
+{
+    LockFreeStack *stack = LockFreeStack__new(sizeof(int), 16);
+    ASSERT_NOT_NULL(stack, "LockFreeStack should not be NULL");
+    ASSERT_EQ(stack->capacity, 16, "Capacity should be kept");
+
+    int value;
+    ASSERT_EQ(LockFreeStack__pop(stack, &value), -1, "Pop on empty stack should fail");
+    LockFreeStack__del(stack);
+}
+
+// Test: LIFO order and bounded capacity on one thread
+TEST(test_lockfreestack_lifo)
+{
+    LockFreeStack *stack = LockFreeStack__new(sizeof(int), 4);
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(LockFreeStack__push(stack, &i), 0, "Push should succeed");
+    }
+
+    int extra = 4;
+    ASSERT_EQ(LockFreeStack__push(stack, &extra), -1, "Push on full stack should fail");
+
+    for (int i = 3; i >= 0; i--)
+    {
+        int value = -1;
+        ASSERT_EQ(LockFreeStack__pop(stack, &value), 0, "Pop should succeed");
+        ASSERT_EQ(value, i, "Value should match LIFO order");
+    }
+
+    ASSERT_EQ(LockFreeStack__push(stack, &extra), 0, "Popped nodes should be reused");
+    LockFreeStack__del(stack);
+}
+
+// Test: Every pushed value is popped exactly once across threads
+TEST(test_lockfreestack_concurrent)
+{
+    LockFreeStack *stack = LockFreeStack__new(sizeof(long long), 64);
+    pthread_t threads[STRESS_THREADS];
+    StressContext contexts[STRESS_THREADS];
+    long long popped = 0;
+    long long value;
+
+    for (int t = 0; t < STRESS_THREADS; t++)
+    {
+        contexts[t] = (StressContext){stack, t, 0};
+        pthread_create(&threads[t], NULL, sStressWorker, &contexts[t]);
+    }
+
+    for (int t = 0; t < STRESS_THREADS; t++)
+    {
+        pthread_join(threads[t], NULL);
+        popped += contexts[t].popped;
+    }
+
+    while (LockFreeStack__pop(stack, &value) == 0)
+    {
+        popped += value;
+    }
+
+    long long total = (long long)STRESS_THREADS * STRESS_ITERATIONS;
+    ASSERT(popped == total * (total - 1) / 2, "Values should be neither lost nor duplicated");
+
+    LockFreeStack__del(stack);
+}
@@ -0,0 +1,136 @@
+#include <cbarroso/lrucache.h>
+#include <ccauchy.h>
+
+typedef struct EvictionLog
+{
+    int keys[16];
+    int count;
+} EvictionLog;
+
+static void sRecordEviction(void *key, size_t keySize, void *value, size_t valueSize, void *context)
+{
+    (void)keySize;
+    (void)value;
+    (void)valueSize;
+    EvictionLog *log = context;
+    log->keys[log->count++] = *(int *)key;
+}
+
+// Test: Create a new LruCache
+TEST(test_lrucache_new)
+{
+    LruCache *cache = LruCache__new(1024, LRU_CACHE_MODE_EXACT, NULL, NULL);
+    ASSERT_NOT_NULL(cache, "LruCache should not be NULL");
+    ASSERT_EQ(cache->usedBytes, 0, "LruCache should be empty");
+    ASSERT(cache->head == NULL, "Recency list should be empty");
+    LruCache__del(cache);
+}
+
+// Test: Put and get items
+TEST(test_lrucache_put_and_get)
+{
+    LruCache *cache = LruCache__new(1024, LRU_CACHE_MODE_EXACT, NULL, NULL);
+    ASSERT_NOT_NULL(cache, "LruCache should not be NULL");
+
+    char *key = "answer";
+    int value = 42;
+    int8_t result = LruCache__put(cache, key, strlen(key) + 1, &value, sizeof(int));
+    ASSERT_EQ(result, 0, "put should succeed");
+    ASSERT_EQ(cache->usedBytes, strlen(key) + 1 + sizeof(int), "Usage should count key and value");
+
+    void *retrieved = NULL;
+    LruCache__get(cache, key, strlen(key) + 1, &retrieved);
+    ASSERT_NOT_NULL(retrieved, "Retrieved value should not be NULL");
+    ASSERT_EQ(*(int *)retrieved, 42, "Retrieved value should match");
+
+    value = 43;
+    LruCache__put(cache, key, strlen(key) + 1, &value, sizeof(int));
+    LruCache__get(cache, key, strlen(key) + 1, &retrieved);
+    ASSERT_EQ(*(int *)retrieved, 43, "Replacing should update the value");
+    ASSERT_EQ(cache->usedBytes, strlen(key) + 1 + sizeof(int), "Replacing should not grow usage");
+
+    ASSERT_EQ(LruCache__remove(cache, key, strlen(key) + 1), 0, "remove should succeed");
+    LruCache__get(cache, key, strlen(key) + 1, &retrieved);
+    ASSERT(retrieved == NULL, "Removed key should not be found");
+    ASSERT_EQ(cache->usedBytes, 0, "Removing should release usage");
+
+    LruCache__del(cache);
+}
+
+// Test: Least recently used items are evicted first
+TEST(test_lrucache_eviction_order)
+{
+    EvictionLog log = {{0}, 0};
+    // Room for four int/int items
+    LruCache *cache = LruCache__new(4 * 2 * sizeof(int), LRU_CACHE_MODE_EXACT, sRecordEviction, &log);
+    ASSERT_NOT_NULL(cache, "LruCache should not be NULL");
+
+    for (int i = 0; i < 4; i++)
+    {
+        LruCache__put(cache, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    ASSERT_EQ(log.count, 0, "Nothing should be evicted within budget");
+
+    // Touch 0 so that 1 becomes the oldest
+    void *retrieved = NULL;
+    int key = 0;
+    LruCache__get(cache, &key, sizeof(int), &retrieved);
+
+    for (int i = 4; i < 6; i++)
+    {
+        LruCache__put(cache, &i, sizeof(int), &i, sizeof(int));
+    }
+
+    ASSERT_EQ(log.count, 2, "Two items should be evicted");
+    ASSERT_EQ(log.keys[0], 1, "Key 1 should be evicted first");
+    ASSERT_EQ(log.keys[1], 2, "Key 2 should be evicted second");
+    ASSERT(cache->usedBytes <= cache->maxBytes, "Usage should stay within budget");
+
+    LruCache__get(cache, &key, sizeof(int), &retrieved);
+    ASSERT_NOT_NULL(retrieved, "Recently used key should survive");
+
+    LruCache__del(cache);
+}
+
+// Test: Items larger than the budget are refused
+TEST(test_lrucache_oversized_item)
+{
+    LruCache *cache = LruCache__new(8, LRU_CACHE_MODE_EXACT, NULL, NULL);
+    ASSERT_NOT_NULL(cache, "LruCache should not be NULL");
+
+    char value[16] = {0};
+    int key = 1;
+    ASSERT_EQ(LruCache__put(cache, &key, sizeof(int), value, sizeof(value)), -1,
+              "Oversized item should be refused");
+
+    LruCache__del(cache);
+}
+
+// Test: Sampled mode keeps within budget and favours hot keys
+TEST(test_lrucache_sampled)
+{
+    LruCache *cache = LruCache__new(16 * 2 * sizeof(int), LRU_CACHE_MODE_SAMPLED, NULL, NULL);
+    ASSERT_NOT_NULL(cache, "LruCache should not be NULL");
+
+    int hotKey = -1;
+    LruCache__put(cache, &hotKey, sizeof(int), &hotKey, sizeof(int));
+
+    for (int i = 0; i < 200; i++)
+    {
+        void *retrieved = NULL;
+        LruCache__get(cache, &hotKey, sizeof(int), &retrieved);
+        ASSERT_NOT_NULL(retrieved, "Hot key should stay cached");
+
+        LruCache__put(cache, &i, sizeof(int), &i, sizeof(int));
+        ASSERT(cache->usedBytes <= cache->maxBytes, "Usage should stay within budget");
+
+        LruCache__get(cache, &i, sizeof(int), &retrieved);
+        ASSERT_NOT_NULL(retrieved, "A put should never evict the item it inserts");
+    }
+
+    ASSERT(cache->head == NULL, "Sampled mode should not maintain the list");
+    ASSERT_EQ(cache->numberOfNodes, 16, "Cache should be full");
+
+    LruCache__del(cache);
+}
@@ -0,0 +1,113 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <cbarroso/mpmcqueue.h>
+#include <ccauchy.h>
+
+#define WORKERS 4
+#define JOBS_PER_PRODUCER 20000
+
+typedef struct Worker
+{
+    MpmcQueue *queue;
+    long id;
+    long long sum;
+} Worker;
+
+static void *sProducer(void *argument)
+{
+    Worker *worker = argument;
+
+    for (long i = 0; i < JOBS_PER_PRODUCER; i++)
+    {
+        long job = worker->id * JOBS_PER_PRODUCER + i;
+        MpmcQueue__enqueue(worker->queue, &job);
+    }
+
+    return NULL;
+}
+
+static void *sConsumer(void *argument)
+{
+    Worker *worker = argument;
+
+    for (long i = 0; i < JOBS_PER_PRODUCER; i++)
+    {
+        long job;
+        MpmcQueue__dequeue(worker->queue, &job);
+        worker->sum += job;
+    }
+
+    return NULL;
+}
+
+// Test: Create a new MpmcQueue
+TEST(test_mpmcqueue_new)
+{
+    MpmcQueue *queue = MpmcQueue__new(sizeof(int), 100);
+    ASSERT_NOT_NULL(queue, "MpmcQueue should not be NULL");
+    ASSERT_EQ(queue->capacity, 128, "Capacity should round up to a power of two");
+
+    int value;
+    ASSERT_EQ(MpmcQueue__tryDequeue(queue, &value), -1, "Dequeue on empty queue should fail");
+    ASSERT(MpmcQueue__new(sizeof(int), SIZE_MAX) == NULL, "Oversized capacity should be rejected");
+    MpmcQueue__del(queue);
+}
+
+// Test: FIFO order and bounded capacity over several laps
+TEST(test_mpmcqueue_try)
+{
+    MpmcQueue *queue = MpmcQueue__new(3, 4);
+    char value[3];
+
+    for (int lap = 0; lap < 3; lap++)
+    {
+        for (char i = 0; i < 4; i++)
+        {
+            char element[3] = {i, (char)lap, 'x'};
+            ASSERT_EQ(MpmcQueue__tryEnqueue(queue, element), 0, "Enqueue should succeed");
+        }
+
+        ASSERT_EQ(MpmcQueue__tryEnqueue(queue, value), -1, "Enqueue on full queue should fail");
+
+        for (char i = 0; i < 4; i++)
+        {
+            ASSERT_EQ(MpmcQueue__tryDequeue(queue, value), 0, "Dequeue should succeed");
+            ASSERT(value[0] == i && value[1] == lap && value[2] == 'x', "Element should match FIFO order");
+        }
+    }
+
+    MpmcQueue__del(queue);
+}
+
+// Test: Every job is consumed exactly once across threads
+TEST(test_mpmcqueue_concurrent)
+{
+    MpmcQueue *queue = MpmcQueue__new(sizeof(long), 64);
+    pthread_t producers[WORKERS];
+    pthread_t consumers[WORKERS];
+    Worker producerContexts[WORKERS];
+    Worker consumerContexts[WORKERS];
+    long long sum = 0;
+
+    for (long t = 0; t < WORKERS; t++)
+    {
+        producerContexts[t] = (Worker){queue, t, 0};
+        consumerContexts[t] = (Worker){queue, t, 0};
+        pthread_create(&consumers[t], NULL, sConsumer, &consumerContexts[t]);
+        pthread_create(&producers[t], NULL, sProducer, &producerContexts[t]);
+    }
+
+    for (int t = 0; t < WORKERS; t++)
+    {
+        pthread_join(producers[t], NULL);
+        pthread_join(consumers[t], NULL);
+        sum += consumerContexts[t].sum;
+    }
+
+    long long total = (long long)WORKERS * JOBS_PER_PRODUCER;
+    ASSERT(sum == total * (total - 1) / 2, "Jobs should be neither lost nor duplicated");
+
+    long job;
+    ASSERT_EQ(MpmcQueue__tryDequeue(queue, &job), -1, "Queue should be drained");
+    MpmcQueue__del(queue);
+}
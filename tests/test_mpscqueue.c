@@ -0,0 +1,137 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <cbarroso/mpscqueue.h>
+#include <ccauchy.h>
+
+#define PRODUCERS 4
+#define MESSAGES_PER_PRODUCER 20000
+
+typedef struct Message
+{
+    MpscQueueNode node;
+    int producer;
+    int sequence;
+} Message;
+
+typedef struct Producer
+{
+    MpscQueue *queue;
+    Message *messages;
+    int id;
+} Producer;
+
+static void *sProducer(void *argument)
+{
+    Producer *producer = argument;
+
+    for (int i = 0; i < MESSAGES_PER_PRODUCER; i++)
+    {
+        Message *message = &producer->messages[i];
+        message->producer = producer->id;
+        message->sequence = i;
+        MpscQueueNode__init(&message->node, message, sizeof(Message));
+        MpscQueue__enqueue(producer->queue, &message->node);
+    }
+
+    return NULL;
+}
+
+// Test: Create a new MpscQueue
+TEST(test_mpscqueue_new)
+{
+    MpscQueue *queue = MpscQueue__new();
+    ASSERT_NOT_NULL(queue, "MpscQueue should not be NULL");
+    ASSERT(MpscQueue__dequeue(queue) == NULL, "Empty queue should return NULL");
+    MpscQueue__del(queue);
+}
+
+// Test: FIFO order and draining on one thread
+TEST(test_mpscqueue_fifo_and_drain)
+{
+    MpscQueue *queue = MpscQueue__new();
+    MpscQueueNode nodes[10];
+    int values[10];
+
+    for (int i = 0; i < 10; i++)
+    {
+        values[i] = i;
+        MpscQueueNode__init(&nodes[i], &values[i], sizeof(int));
+        MpscQueue__enqueue(queue, &nodes[i]);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        MpscQueueNode *node = MpscQueue__dequeue(queue);
+        ASSERT(node == &nodes[i], "Nodes should come out in FIFO order");
+        ASSERT_EQ(*(int *)node->value, i, "Node should keep its value");
+    }
+
+    size_t count = 0;
+    MpscQueueNode *chain = MpscQueue__drain(queue, &count);
+    ASSERT_EQ(count, 6, "Drain should detach every remaining node");
+
+    for (int i = 4; i < 10; i++)
+    {
+        ASSERT(chain == &nodes[i], "Drained chain should be in FIFO order");
+        chain = chain->next;
+    }
+
+    ASSERT(chain == NULL, "Drained chain should end with NULL");
+    ASSERT(MpscQueue__drain(queue, &count) == NULL, "Drained queue should be empty");
+    ASSERT_EQ(count, 0, "Nothing should be drained twice");
+
+    // Nodes can be enqueued again once drained
+    MpscQueue__enqueue(queue, &nodes[0]);
+    ASSERT(MpscQueue__dequeue(queue) == &nodes[0], "Reused node should be dequeued");
+
+    MpscQueue__del(queue);
+}
+
+// Test: Each producer's messages arrive once and in order
+TEST(test_mpscqueue_producers)
+{
+    MpscQueue *queue = MpscQueue__new();
+    Message *messages = malloc(sizeof(Message) * PRODUCERS * MESSAGES_PER_PRODUCER);
+    pthread_t threads[PRODUCERS];
+    Producer producers[PRODUCERS];
+    int expected[PRODUCERS] = {0};
+    int ordered = 1;
+
+    for (int t = 0; t < PRODUCERS; t++)
+    {
+        producers[t] = (Producer){queue, messages + t * MESSAGES_PER_PRODUCER, t};
+        pthread_create(&threads[t], NULL, sProducer, &producers[t]);
+    }
+
+    for (int received = 0; received < PRODUCERS * MESSAGES_PER_PRODUCER;)
+    {
+        size_t count = 0;
+        MpscQueueNode *node = received % 2 == 0 ? MpscQueue__drain(queue, &count) : MpscQueue__dequeue(queue);
+
+        if (node == NULL)
+        {
+            sched_yield();
+            continue;
+        }
+
+        for (; node != NULL; node = count > 0 ? node->next : NULL)
+        {
+            Message *message = node->value;
+            ordered &= message->sequence == expected[message->producer]++;
+            received++;
+        }
+    }
+
+    for (int t = 0; t < PRODUCERS; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+
+    ASSERT(ordered, "Messages of a producer should stay in order");
+    ASSERT(MpscQueue__dequeue(queue) == NULL, "Queue should be empty");
+
+    free(messages);
+    MpscQueue__del(queue);
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cbarroso/priorityqueue.h>
+#include <ccauchy.h>
+
+static int sCompareInts(const void *left, const void *right, void *context)
+{
+    (void)context;
+    int a = *(const int *)left;
+    int b = *(const int *)right;
+
+    return (a > b) - (a < b);
+}
+
+// Test: Create a new PriorityQueue
+TEST(test_priorityqueue_new)
+{
+    PriorityQueue *queue = PriorityQueue__new(sizeof(int), 0, sCompareInts, NULL);
+    ASSERT_NOT_NULL(queue, "PriorityQueue should not be NULL");
+    ASSERT_EQ(queue->arity, PRIORITY_QUEUE_DEFAULT_ARITY, "Arity should default to 4");
+    ASSERT_EQ(queue->numberOfElements, 0, "PriorityQueue should be empty");
+
+    int value;
+    ASSERT_EQ(PriorityQueue__pop(queue, &value), -1, "Pop on empty queue should fail");
+    PriorityQueue__del(queue);
+}
+
+// Test: Elements come out in order for binary and 4-ary heaps
+TEST(test_priorityqueue_push_pop_order)
+{
+    size_t arities[2] = {2, 4};
+
+    for (int a = 0; a < 2; a++)
+    {
+        PriorityQueue *queue = PriorityQueue__new(sizeof(int), arities[a], sCompareInts, NULL);
+        srand(42);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            int value = rand() % 500;
+            ASSERT_EQ(PriorityQueue__push(queue, &value), 0, "Push should succeed");
+        }
+
+        ASSERT_EQ(queue->numberOfElements, 1000, "Every element should be queued");
+
+        int previous = -1;
+
+        while (queue->numberOfElements > 0)
+        {
+            void *peeked;
+            int value;
+            PriorityQueue__peek(queue, &peeked);
+            int head = *(int *)peeked;
+            PriorityQueue__pop(queue, &value);
+            ASSERT_EQ(value, head, "Pop should return the peeked element");
+            ASSERT(value >= previous, "Elements should come out in ascending order");
+            previous = value;
+        }
+
+        PriorityQueue__del(queue);
+    }
+}
+
+// Test: Heapify an array in place
+TEST(test_priorityqueue_from_array)
+{
+    int elements[100];
+
+    for (int i = 0; i < 100; i++)
+    {
+        elements[i] = (i * 37) % 100;
+    }
+
+    PriorityQueue *queue = PriorityQueue__fromArray(sizeof(int), 4, sCompareInts, NULL, elements, 100);
+    ASSERT_NOT_NULL(queue, "PriorityQueue should not be NULL");
+    ASSERT_EQ(queue->numberOfElements, 100, "Every element should be queued");
+
+    int value = 50;
+    PriorityQueue__push(queue, &value);
+
+    for (int i = 0; i <= 100; i++)
+    {
+        PriorityQueue__pop(queue, &value);
+        ASSERT_EQ(value, i <= 50 ? i : i - 1, "Elements should come out in ascending order");
+    }
+
+    PriorityQueue__del(queue);
+}
+
+// Test: Dijkstra with decrease-key on the indexed variant
+TEST(test_priorityqueue_indexed_dijkstra)
+{
+    // Edges as from, to, weight
+    int edges[8][3] = {{0, 1, 7}, {0, 2, 9}, {0, 5, 14}, {1, 2, 10}, {1, 3, 15}, {2, 3, 11}, {2, 5, 2}, {5, 4, 9}};
+    int expected[6] = {0, 7, 9, 20, 20, 11};
+    int distances[6];
+    IndexedPriorityQueue *queue = IndexedPriorityQueue__new(sizeof(int), 0, 6, sCompareInts, NULL);
+    ASSERT_NOT_NULL(queue, "IndexedPriorityQueue should not be NULL");
+
+    for (uint32_t id = 0; id < 6; id++)
+    {
+        distances[id] = id == 0 ? 0 : 1000;
+        IndexedPriorityQueue__push(queue, id, &distances[id]);
+    }
+
+    ASSERT_EQ(IndexedPriorityQueue__push(queue, 3, &distances[3]), -1, "Pushing a queued ID should fail");
+
+    int larger = 2000;
+    ASSERT_EQ(IndexedPriorityQueue__decreaseKey(queue, 1, &larger), -1, "Increasing a key should fail");
+
+    while (queue->numberOfElements > 0)
+    {
+        uint32_t id;
+        int distance;
+        IndexedPriorityQueue__pop(queue, &id, &distance);
+        ASSERT(!IndexedPriorityQueue__contains(queue, id), "Popped ID should leave the queue");
+
+        for (int e = 0; e < 8; e++)
+        {
+            for (int side = 0; side < 2; side++)
+            {
+                uint32_t from = (uint32_t)edges[e][side];
+                uint32_t to = (uint32_t)edges[e][1 - side];
+                int candidate = distance + edges[e][2];
+
+                if (from == id && IndexedPriorityQueue__contains(queue, to) && candidate < distances[to])
+                {
+                    distances[to] = candidate;
+                    ASSERT_EQ(IndexedPriorityQueue__decreaseKey(queue, to, &candidate), 0, "Decrease key should succeed");
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_EQ(distances[i], expected[i], "Shortest distance should match");
+    }
+
+    IndexedPriorityQueue__del(queue);
+}
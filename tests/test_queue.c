@@ -276,3 +276,33 @@ TEST(test_queue_alternating_operations)
     }
     free(queue);
 }
+
+// Test: Dequeue into a caller buffer and peek without copying
+TEST(test_queue_dequeue_into)
+{
+    Queue *queue = Queue__new();
+    ASSERT_NOT_NULL(queue, "Queue should not be NULL");
+
+    Queue__enqueue(queue, "first", 6);
+    Queue__enqueue(queue, "second", 7);
+
+    void *peeked;
+    size_t size = 0;
+    ASSERT_EQ(Queue__peek(queue, &peeked, &size), 0, "Peek should succeed");
+    ASSERT_STR_EQ((char *)peeked, "first", "Peek should return the head");
+    ASSERT_EQ(size, 6, "Peek should return the size");
+
+    char buffer[8];
+    ASSERT_EQ(Queue__dequeueInto(queue, buffer, 3, &size), -1, "Short buffer should be rejected");
+    ASSERT_EQ(size, 6, "Needed size should be reported");
+    ASSERT_EQ(queue->numberOfNodes, 2, "Value should stay queued");
+
+    ASSERT_EQ(Queue__dequeueInto(queue, buffer, sizeof(buffer), &size), 0, "Dequeue should succeed");
+    ASSERT_STR_EQ(buffer, "first", "Should dequeue 'first'");
+    ASSERT_EQ(Queue__dequeueInto(queue, buffer, sizeof(buffer), NULL), 0, "Dequeue should succeed");
+    ASSERT_STR_EQ(buffer, "second", "Should dequeue 'second'");
+    ASSERT_EQ(Queue__dequeueInto(queue, buffer, sizeof(buffer), NULL), -1, "Empty queue should fail");
+    ASSERT_EQ(Queue__peek(queue, &peeked, NULL), -1, "Peek on empty queue should fail");
+
+    Queue__del(queue);
+}
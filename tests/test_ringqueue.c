@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <cbarroso/ringqueue.h>
+#include <ccauchy.h>
+
+// Test: Create a new RingQueue
+TEST(test_ringqueue_new)
+{
+    RingQueue *queue = RingQueue__new(sizeof(int), 100);
+    ASSERT_NOT_NULL(queue, "RingQueue should not be NULL");
+    ASSERT_EQ(queue->capacity, 128, "Capacity should round up to a power of two");
+    ASSERT_EQ(queue->numberOfElements, 0, "RingQueue should be empty");
+
+    int value;
+    ASSERT_EQ(RingQueue__dequeue(queue, &value), -1, "Dequeue on empty queue should fail");
+    ASSERT(RingQueue__new(sizeof(int), SIZE_MAX) == NULL, "Oversized capacity should be rejected");
+    RingQueue__del(queue);
+}
+
+// Test: FIFO order is kept when the ring wraps and grows
+TEST(test_ringqueue_wrap_and_grow)
+{
+    RingQueue *queue = RingQueue__new(sizeof(int), 16);
+    int next = 0;
+    int expected = 0;
+
+    // Move the head to the middle so the ring wraps before growing
+    for (int i = 0; i < 10; i++)
+    {
+        RingQueue__enqueue(queue, &next);
+        next++;
+        int value;
+        RingQueue__dequeue(queue, &value);
+        ASSERT_EQ(value, expected++, "Value should match FIFO order");
+    }
+
+    for (int i = 0; i < 100; i++)
+    {
+        RingQueue__enqueue(queue, &next);
+        next++;
+    }
+
+    ASSERT_EQ(queue->capacity, 128, "Ring should double until the elements fit");
+    ASSERT_EQ(queue->numberOfElements, 100, "Every element should be queued");
+
+    void *peeked;
+    RingQueue__peek(queue, &peeked);
+    ASSERT_EQ(*(int *)peeked, expected, "Peek should return the head");
+
+    while (queue->numberOfElements > 0)
+    {
+        int value;
+        RingQueue__dequeue(queue, &value);
+        ASSERT_EQ(value, expected++, "Value should match FIFO order after growing");
+    }
+
+    ASSERT_EQ(expected, next, "Every element should be dequeued");
+    RingQueue__del(queue);
+}
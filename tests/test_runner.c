@@ -17,6 +17,10 @@ void test_stack_alternating_operations(void);
 void test_stack_size_tracking(void);
 void test_stack_different_sizes(void);
 void test_stack_deep_copy(void);
+void test_stack_fixed(void);
+void test_stack_variable_growth(void);
+void test_stack_pop_into(void);
+void test_stack_mark_rollback(void);
 
 // Queue tests
 void test_queue_new(void);
@@ -30,6 +34,7 @@ void test_queue_enqueue_structs(void);
 void test_queue_mixed_operations(void);
 void test_queue_large(void);
 void test_queue_alternating_operations(void);
+void test_queue_dequeue_into(void);
 
 // HashMap tests
 void test_hashmap_new(void);
@@ -50,6 +55,122 @@ void test_hashmap_mixed_key_types(void);
 void test_hashmap_long_integer_key(void);
 void test_hashmap_complex_binary_key(void);
 void test_hashmap_pointer_key(void);
+void test_hashmap_set_existing_key(void);
+void test_hashmap_resize(void);
+void test_hashmap_iterator(void);
+void test_hashmap_scan(void);
+void test_hashmap_stats(void);
+void test_hashmap_del_item(void);
+void test_hashmap_scan_with_removals(void);
+void test_hashmap_digest(void);
+void test_hashmap_aggregation(void);
+void test_hashmap_aggregation_batch(void);
+void test_hashmap_ttl(void);
+void test_hashmap_reserve(void);
+
+// HashJoin tests
+void test_hashjoin_new(void);
+void test_hashjoin_duplicate_keys(void);
+void test_hashjoin_resume(void);
+
+// LruCache tests
+void test_lrucache_new(void);
+void test_lrucache_put_and_get(void);
+void test_lrucache_eviction_order(void);
+void test_lrucache_oversized_item(void);
+void test_lrucache_sampled(void);
+
+// TimingWheel tests
+void test_timingwheel_new(void);
+void test_timingwheel_expiry_order(void);
+void test_timingwheel_cancel(void);
+void test_timingwheel_budget(void);
+
+// Hamt tests
+void test_hamt_new(void);
+void test_hamt_persistence(void);
+void test_hamt_remove(void);
+void test_hamt_collisions(void);
+
+// SymbolTable tests
+void test_symboltable_new(void);
+void test_symboltable_intern(void);
+void test_symboltable_growth(void);
+
+// BloomFilter tests
+void test_bloomfilter_new(void);
+void test_bloomfilter_false_positives(void);
+void test_bloomfilter_hashed(void);
+void test_bloomfilter_serialize(void);
+
+// HyperLogLog tests
+void test_hyperloglog_new(void);
+void test_hyperloglog_estimate(void);
+void test_hyperloglog_merge(void);
+
+// CountMinSketch tests
+void test_countmin_new(void);
+void test_countmin_estimate(void);
+void test_countmin_merge(void);
+
+// HashRing tests
+void test_hashring_new(void);
+void test_hashring_weights(void);
+void test_hashring_rebalance(void);
+void test_hashring_jump(void);
+
+// LockFreeStack tests
+void test_lockfreestack_new(void);
+void test_lockfreestack_lifo(void);
+void test_lockfreestack_concurrent(void);
+
+// RingQueue tests
+void test_ringqueue_new(void);
+void test_ringqueue_wrap_and_grow(void);
+
+// SpscQueue tests
+void test_spscqueue_new(void);
+void test_spscqueue_batches(void);
+void test_spscqueue_two_threads(void);
+
+// MpmcQueue tests
+void test_mpmcqueue_new(void);
+void test_mpmcqueue_try(void);
+void test_mpmcqueue_concurrent(void);
+
+// MpscQueue tests
+void test_mpscqueue_new(void);
+void test_mpscqueue_fifo_and_drain(void);
+void test_mpscqueue_producers(void);
+
+// BlockingQueue tests
+void test_blockingqueue_new(void);
+void test_blockingqueue_timeout(void);
+void test_blockingqueue_batches(void);
+
+// ChunkedQueue tests
+void test_chunkedqueue_new(void);
+void test_chunkedqueue_fifo_across_blocks(void);
+void test_chunkedqueue_block_reuse(void);
+
+// PriorityQueue tests
+void test_priorityqueue_new(void);
+void test_priorityqueue_push_pop_order(void);
+void test_priorityqueue_from_array(void);
+void test_priorityqueue_indexed_dijkstra(void);
+
+// WorkStealingDeque tests
+void test_workstealingdeque_new(void);
+void test_workstealingdeque_order_and_growth(void);
+void test_workstealingdeque_stress(void);
+
+#ifdef __linux__
+// EventQueue tests
+void test_eventqueue_new(void);
+void test_eventqueue_coalescing(void);
+void test_eventqueue_epoll(void);
+void test_eventqueue_concurrent_drain(void);
+#endif
 
 // DoublyLinkedList tests
 void test_dblylnkdlist_create_node(void);
@@ -96,6 +217,10 @@ int main(void)
     RUN_TEST(test_stack_size_tracking);
     RUN_TEST(test_stack_different_sizes);
     RUN_TEST(test_stack_deep_copy);
+    RUN_TEST(test_stack_fixed);
+    RUN_TEST(test_stack_variable_growth);
+    RUN_TEST(test_stack_pop_into);
+    RUN_TEST(test_stack_mark_rollback);
 
     // Queue Tests
     printf("\n--- Queue Tests ---\n");
@@ -110,6 +235,7 @@ int main(void)
     RUN_TEST(test_queue_mixed_operations);
     RUN_TEST(test_queue_large);
     RUN_TEST(test_queue_alternating_operations);
+    RUN_TEST(test_queue_dequeue_into);
 
     // HashMap Tests
     printf("\n--- HashMap Tests ---\n");
@@ -131,6 +257,141 @@ int main(void)
     RUN_TEST(test_hashmap_long_integer_key);
     RUN_TEST(test_hashmap_complex_binary_key);
     RUN_TEST(test_hashmap_pointer_key);
+    RUN_TEST(test_hashmap_set_existing_key);
+    RUN_TEST(test_hashmap_resize);
+    RUN_TEST(test_hashmap_iterator);
+    RUN_TEST(test_hashmap_scan);
+    RUN_TEST(test_hashmap_stats);
+    RUN_TEST(test_hashmap_del_item);
+    RUN_TEST(test_hashmap_scan_with_removals);
+    RUN_TEST(test_hashmap_digest);
+    RUN_TEST(test_hashmap_aggregation);
+    RUN_TEST(test_hashmap_aggregation_batch);
+    RUN_TEST(test_hashmap_ttl);
+    RUN_TEST(test_hashmap_reserve);
+
+    // HashJoin Tests
+    printf("\n--- HashJoin Tests ---\n");
+    RUN_TEST(test_hashjoin_new);
+    RUN_TEST(test_hashjoin_duplicate_keys);
+    RUN_TEST(test_hashjoin_resume);
+
+    // LruCache Tests
+    printf("\n--- LruCache Tests ---\n");
+    RUN_TEST(test_lrucache_new);
+    RUN_TEST(test_lrucache_put_and_get);
+    RUN_TEST(test_lrucache_eviction_order);
+    RUN_TEST(test_lrucache_oversized_item);
+    RUN_TEST(test_lrucache_sampled);
+
+    // TimingWheel Tests
+    printf("\n--- TimingWheel Tests ---\n");
+    RUN_TEST(test_timingwheel_new);
+    RUN_TEST(test_timingwheel_expiry_order);
+    RUN_TEST(test_timingwheel_cancel);
+    RUN_TEST(test_timingwheel_budget);
+
+    // Hamt Tests
+    printf("\n--- Hamt Tests ---\n");
+    RUN_TEST(test_hamt_new);
+    RUN_TEST(test_hamt_persistence);
+    RUN_TEST(test_hamt_remove);
+    RUN_TEST(test_hamt_collisions);
+
+    // SymbolTable Tests
+    printf("\n--- SymbolTable Tests ---\n");
+    RUN_TEST(test_symboltable_new);
+    RUN_TEST(test_symboltable_intern);
+    RUN_TEST(test_symboltable_growth);
+
+    // BloomFilter Tests
+    printf("\n--- BloomFilter Tests ---\n");
+    RUN_TEST(test_bloomfilter_new);
+    RUN_TEST(test_bloomfilter_false_positives);
+    RUN_TEST(test_bloomfilter_hashed);
+    RUN_TEST(test_bloomfilter_serialize);
+
+    // HyperLogLog Tests
+    printf("\n--- HyperLogLog Tests ---\n");
+    RUN_TEST(test_hyperloglog_new);
+    RUN_TEST(test_hyperloglog_estimate);
+    RUN_TEST(test_hyperloglog_merge);
+
+    // CountMinSketch Tests
+    printf("\n--- CountMinSketch Tests ---\n");
+    RUN_TEST(test_countmin_new);
+    RUN_TEST(test_countmin_estimate);
+    RUN_TEST(test_countmin_merge);
+
+    // HashRing Tests
+    printf("\n--- HashRing Tests ---\n");
+    RUN_TEST(test_hashring_new);
+    RUN_TEST(test_hashring_weights);
+    RUN_TEST(test_hashring_rebalance);
+    RUN_TEST(test_hashring_jump);
+
+    // LockFreeStack Tests
+    printf("\n--- LockFreeStack Tests ---\n");
+    RUN_TEST(test_lockfreestack_new);
+    RUN_TEST(test_lockfreestack_lifo);
+    RUN_TEST(test_lockfreestack_concurrent);
+
+    // RingQueue Tests
+    printf("\n--- RingQueue Tests ---\n");
+    RUN_TEST(test_ringqueue_new);
+    RUN_TEST(test_ringqueue_wrap_and_grow);
+
+    // SpscQueue Tests
+    printf("\n--- SpscQueue Tests ---\n");
+    RUN_TEST(test_spscqueue_new);
+    RUN_TEST(test_spscqueue_batches);
+    RUN_TEST(test_spscqueue_two_threads);
+
+    // MpmcQueue Tests
+    printf("\n--- MpmcQueue Tests ---\n");
+    RUN_TEST(test_mpmcqueue_new);
+    RUN_TEST(test_mpmcqueue_try);
+    RUN_TEST(test_mpmcqueue_concurrent);
+
+    // MpscQueue Tests
+    printf("\n--- MpscQueue Tests ---\n");
+    RUN_TEST(test_mpscqueue_new);
+    RUN_TEST(test_mpscqueue_fifo_and_drain);
+    RUN_TEST(test_mpscqueue_producers);
+
+    // BlockingQueue Tests
+    printf("\n--- BlockingQueue Tests ---\n");
+    RUN_TEST(test_blockingqueue_new);
+    RUN_TEST(test_blockingqueue_timeout);
+    RUN_TEST(test_blockingqueue_batches);
+
+    // ChunkedQueue Tests
+    printf("\n--- ChunkedQueue Tests ---\n");
+    RUN_TEST(test_chunkedqueue_new);
+    RUN_TEST(test_chunkedqueue_fifo_across_blocks);
+    RUN_TEST(test_chunkedqueue_block_reuse);
+
+    // PriorityQueue Tests
+    printf("\n--- PriorityQueue Tests ---\n");
+    RUN_TEST(test_priorityqueue_new);
+    RUN_TEST(test_priorityqueue_push_pop_order);
+    RUN_TEST(test_priorityqueue_from_array);
+    RUN_TEST(test_priorityqueue_indexed_dijkstra);
+
+    // WorkStealingDeque Tests
+    printf("\n--- WorkStealingDeque Tests ---\n");
+    RUN_TEST(test_workstealingdeque_new);
+    RUN_TEST(test_workstealingdeque_order_and_growth);
+    RUN_TEST(test_workstealingdeque_stress);
+
+#ifdef __linux__
+    // EventQueue Tests
+    printf("\n--- EventQueue Tests ---\n");
+    RUN_TEST(test_eventqueue_new);
+    RUN_TEST(test_eventqueue_coalescing);
+    RUN_TEST(test_eventqueue_epoll);
+    RUN_TEST(test_eventqueue_concurrent_drain);
+#endif
 
     // DoublyLinkedList Tests
     printf("\n--- DoublyLinkedList Tests ---\n");
@@ -0,0 +1,119 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <cbarroso/spscqueue.h>
+#include <ccauchy.h>
+
+#define HANDOFF_MESSAGES 200000
+
+static void *sProducer(void *argument)
+{
+    SpscQueue *queue = argument;
+    long values[7];
+    long next = 0;
+
+    while (next < HANDOFF_MESSAGES)
+    {
+        // Alternate single and batch enqueues
+        if (next % 2 == 0)
+        {
+            if (SpscQueue__enqueue(queue, &next) == 0)
+            {
+                next++;
+            }
+            else
+            {
+                sched_yield();
+            }
+
+            continue;
+        }
+
+        size_t count = 0;
+
+        while (count < 7 && next + (long)count < HANDOFF_MESSAGES)
+        {
+            values[count] = next + (long)count;
+            count++;
+        }
+
+        size_t enqueued = SpscQueue__enqueueBatch(queue, values, count);
+
+        if (enqueued == 0)
+        {
+            sched_yield();
+        }
+
+        next += (long)enqueued;
+    }
+
+    return NULL;
+}
+
+// Test: Create a new SpscQueue
+TEST(test_spscqueue_new)
+{
+    SpscQueue *queue = SpscQueue__new(sizeof(int), 100);
+    ASSERT_NOT_NULL(queue, "SpscQueue should not be NULL");
+    ASSERT_EQ(queue->capacity, 128, "Capacity should round up to a power of two");
+
+    int value;
+    ASSERT_EQ(SpscQueue__dequeue(queue, &value), -1, "Dequeue on empty queue should fail");
+    ASSERT(SpscQueue__new(sizeof(int), SIZE_MAX) == NULL, "Oversized capacity should be rejected");
+    SpscQueue__del(queue);
+}
+
+// Test: Bounded capacity and batches wrapping around the ring
+TEST(test_spscqueue_batches)
+{
+    SpscQueue *queue = SpscQueue__new(sizeof(int), 8);
+    int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int out[10];
+
+    ASSERT_EQ(SpscQueue__enqueueBatch(queue, values, 5), 5, "Batch should be enqueued");
+    ASSERT_EQ(SpscQueue__dequeueBatch(queue, out, 3), 3, "Batch should be dequeued");
+    ASSERT_EQ(out[2], 2, "Batch should keep FIFO order");
+
+    ASSERT_EQ(SpscQueue__enqueueBatch(queue, values, 10), 6, "Only the free slots should be filled");
+    ASSERT_EQ(SpscQueue__enqueue(queue, &values[0]), -1, "Enqueue on full queue should fail");
+
+    ASSERT_EQ(SpscQueue__dequeueBatch(queue, out, 10), 8, "Every element should be dequeued");
+    ASSERT_EQ(out[0], 3, "Remaining elements should come first");
+    ASSERT_EQ(out[2], 0, "Wrapped batch should follow");
+    ASSERT_EQ(out[7], 5, "Wrapped batch should keep its order");
+
+    SpscQueue__del(queue);
+}
+
+// Test: Messages cross threads in order
+TEST(test_spscqueue_two_threads)
+{
+    SpscQueue *queue = SpscQueue__new(sizeof(long), 64);
+    pthread_t producer;
+    long expected = 0;
+    long values[16];
+    int ordered = 1;
+
+    pthread_create(&producer, NULL, sProducer, queue);
+
+    while (expected < HANDOFF_MESSAGES)
+    {
+        size_t count = SpscQueue__dequeueBatch(queue, values, 16);
+
+        if (count == 0)
+        {
+            sched_yield();
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ordered &= values[i] == expected++;
+        }
+    }
+
+    pthread_join(producer, NULL);
+    ASSERT(ordered, "Messages should arrive in order");
+    ASSERT_EQ(expected, HANDOFF_MESSAGES, "Every message should arrive");
+
+    SpscQueue__del(queue);
+}
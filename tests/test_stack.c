@@ -373,3 +373,125 @@ TEST(test_stack_deep_copy)
 
     stack = Stack__del(stack);
 }
+
+// Test: Fixed-size elements are stored inline
+TEST(test_stack_fixed)
+{
+    Stack *stack = Stack__newFixed(sizeof(int));
+    ASSERT_NOT_NULL(stack, "Stack should not be NULL");
+
+    for (int i = 0; i < 1000; i++)
+    {
+        Stack__push(stack, &i, sizeof(int));
+        ASSERT_EQ(*(int *)stack->top, i, "Top should point at the last value");
+    }
+
+    ASSERT_EQ(stack->used, 1000 * sizeof(int), "Elements should have no overhead");
+
+    long wrongSize = 0;
+    ASSERT_EQ(Stack__push(stack, &wrongSize, sizeof(long)), -1, "Other sizes should be rejected");
+
+    for (int i = 999; i >= 0; i--)
+    {
+        void *popped;
+        Stack__pop(stack, &popped);
+        ASSERT_EQ(*(int *)popped, i, "Value should match LIFO order");
+        free(popped);
+    }
+
+    ASSERT(stack->top == NULL, "Stack top should be NULL when empty");
+    stack = Stack__del(stack);
+}
+
+// Test: Variable-size elements survive the buffer growing
+TEST(test_stack_variable_growth)
+{
+    Stack *stack = Stack__new();
+    char value[300];
+
+    for (int i = 0; i < 300; i++)
+    {
+        memset(value, 'a' + i % 26, (size_t)i);
+        Stack__push(stack, value, (size_t)i);
+    }
+
+    ASSERT(stack->capacity >= stack->used, "Buffer should hold every element");
+
+    for (int i = 299; i >= 0; i--)
+    {
+        void *popped;
+        memset(value, 'a' + i % 26, (size_t)i);
+        Stack__pop(stack, &popped);
+        ASSERT(memcmp(popped, value, (size_t)i) == 0, "Value should keep its bytes and size");
+        free(popped);
+    }
+
+    ASSERT_EQ(stack->used, 0, "Buffer should be empty");
+    stack = Stack__del(stack);
+}
+
+// Test: Pop into a caller buffer and peek without copying
+TEST(test_stack_pop_into)
+{
+    Stack *stack = Stack__new();
+    ASSERT_NOT_NULL(stack, "Stack should not be NULL");
+
+    Stack__push(stack, "bottom", 7);
+    Stack__push(stack, "top", 4);
+
+    void *peeked;
+    size_t size = 0;
+    ASSERT_EQ(Stack__peek(stack, &peeked, &size), 0, "Peek should succeed");
+    ASSERT_STR_EQ((char *)peeked, "top", "Peek should return the top");
+    ASSERT_EQ(size, 4, "Peek should return the size");
+
+    char buffer[8];
+    ASSERT_EQ(Stack__popInto(stack, buffer, 2, &size), -1, "Short buffer should be rejected");
+    ASSERT_EQ(size, 4, "Needed size should be reported");
+    ASSERT_EQ(stack->stackSize, 2, "Value should stay on the stack");
+
+    ASSERT_EQ(Stack__popInto(stack, buffer, sizeof(buffer), &size), 0, "Pop should succeed");
+    ASSERT_STR_EQ(buffer, "top", "Should pop 'top'");
+    ASSERT_EQ(Stack__popInto(stack, buffer, sizeof(buffer), NULL), 0, "Pop should succeed");
+    ASSERT_STR_EQ(buffer, "bottom", "Should pop 'bottom'");
+    ASSERT_EQ(Stack__popInto(stack, buffer, sizeof(buffer), NULL), -1, "Empty stack should fail");
+    ASSERT_EQ(Stack__peek(stack, &peeked, NULL), -1, "Peek on empty stack should fail");
+    ASSERT_EQ(Stack__push(stack, buffer, SIZE_MAX), -1, "Oversized value should be rejected");
+
+    stack = Stack__del(stack);
+}
+
+// Test: Nested marks roll back speculative pushes
+TEST(test_stack_mark_rollback)
+{
+    Stack *stack = Stack__new();
+    ASSERT_NOT_NULL(stack, "Stack should not be NULL");
+
+    StackMark empty = Stack__mark(stack);
+    int base = 1;
+    Stack__push(stack, &base, sizeof(int));
+
+    StackMark outer = Stack__mark(stack);
+    Stack__push(stack, "speculative", 12);
+
+    StackMark inner = Stack__mark(stack);
+    for (int i = 0; i < 100; i++)
+    {
+        Stack__push(stack, &i, sizeof(int));
+    }
+
+    ASSERT_EQ(Stack__rollback(stack, inner), 0, "Inner rollback should succeed");
+    ASSERT_EQ(stack->stackSize, 2, "Inner rollback should keep earlier pushes");
+    ASSERT_STR_EQ((char *)stack->top, "speculative", "Top should be restored");
+
+    ASSERT_EQ(Stack__rollback(stack, outer), 0, "Outer rollback should succeed");
+    ASSERT_EQ(stack->stackSize, 1, "Outer rollback should discard the inner frame");
+    ASSERT_EQ(*(int *)stack->top, 1, "Top should be the base value");
+    ASSERT_EQ(Stack__rollback(stack, inner), -1, "Discarded mark should be rejected");
+
+    ASSERT_EQ(Stack__rollback(stack, empty), 0, "Rollback to empty should succeed");
+    ASSERT(stack->top == NULL, "Stack top should be NULL when empty");
+    ASSERT_EQ(stack->stackSize, 0, "Stack should be empty");
+
+    stack = Stack__del(stack);
+}
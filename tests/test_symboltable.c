@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <string.h>
+#include <cbarroso/symboltable.h>
+#include <ccauchy.h>
+
+// Test: Create a new SymbolTable
+TEST(test_symboltable_new)
+{
+    SymbolTable *table = SymbolTable__new();
+    ASSERT_NOT_NULL(table, "SymbolTable should not be NULL");
+    ASSERT_EQ(table->numberOfSymbols, 0, "SymbolTable should be empty");
+    SymbolTable__del(table);
+}
+
+// Test: Interning gives dense, stable IDs
+TEST(test_symboltable_intern)
+{
+    SymbolTable *table = SymbolTable__new();
+    const char *names[] = {"x", "count", "x", "main", "count"};
+    uint32_t ids[5];
+
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(SymbolTable__intern(table, names[i], strlen(names[i]), &ids[i]), 0, "Interning should succeed");
+    }
+
+    ASSERT_EQ(ids[0], 0, "First symbol should get ID 0");
+    ASSERT_EQ(ids[1], 1, "New symbol should get the next ID");
+    ASSERT_EQ(ids[2], ids[0], "Same string should get the same ID");
+    ASSERT_EQ(ids[3], 2, "IDs should be dense");
+    ASSERT_EQ(ids[4], ids[1], "Same string should get the same ID");
+    ASSERT_EQ(table->numberOfSymbols, 3, "Only unique strings should be stored");
+
+    size_t size = 0;
+    ASSERT_STR_EQ(SymbolTable__lookup(table, ids[3], &size), "main", "Lookup should return the interned bytes");
+    ASSERT_EQ(size, 4, "Lookup should return the size");
+
+    uint32_t id = 0;
+    SymbolTable__find(table, "count", 5, &id);
+    ASSERT_EQ(id, ids[1], "Find should return the existing ID");
+    SymbolTable__find(table, "missing", 7, &id);
+    ASSERT_EQ(id, SYMBOL_TABLE_NO_ID, "Find should not intern");
+    ASSERT(SymbolTable__lookup(table, 3, NULL) == NULL, "Unknown ID should not resolve");
+
+    SymbolTable__del(table);
+}
+
+// Test: Symbols keep their ID and address as the table grows
+TEST(test_symboltable_growth)
+{
+    SymbolTable *table = SymbolTable__new();
+    char name[32];
+    uint32_t id = 0;
+
+    SymbolTable__intern(table, "first", 5, &id);
+    const char *first = SymbolTable__lookup(table, id, NULL);
+
+    for (int i = 0; i < 5000; i++)
+    {
+        int length = snprintf(name, sizeof(name), "symbol_%d", i);
+        SymbolTable__intern(table, name, (size_t)length, &id);
+        ASSERT_EQ(id, (uint32_t)i + 1, "New symbols should get consecutive IDs");
+    }
+
+    char large[SYMBOL_TABLE_BLOCK_SIZE * 2];
+    memset(large, 'a', sizeof(large));
+    SymbolTable__intern(table, large, sizeof(large), &id);
+    ASSERT_EQ(id, 5001, "Oversized symbol should be interned");
+
+    for (int i = 0; i < 5000; i += 7)
+    {
+        int length = snprintf(name, sizeof(name), "symbol_%d", i);
+        SymbolTable__intern(table, name, (size_t)length, &id);
+        ASSERT_EQ(id, (uint32_t)i + 1, "Symbols should keep their ID");
+        ASSERT_STR_EQ(SymbolTable__lookup(table, id, NULL), name, "Symbols should keep their bytes");
+    }
+
+    ASSERT(SymbolTable__lookup(table, 0, NULL) == first, "Symbols should never move");
+    ASSERT_EQ(table->numberOfSymbols, 5002, "Every symbol should be counted");
+
+    SymbolTable__del(table);
+}
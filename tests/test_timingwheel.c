@@ -0,0 +1,120 @@
+#include <cbarroso/timingwheel.h>
+#include <ccauchy.h>
+
+typedef struct ExpiryLog
+{
+    uint64_t ticks[64];
+    int ids[64];
+    int count;
+    TimingWheel *wheel;
+} ExpiryLog;
+
+static void sRecordExpiry(TimingWheelTimer *timer, void *context)
+{
+    ExpiryLog *log = context;
+    log->ticks[log->count] = log->wheel->now;
+    log->ids[log->count] = *(int *)timer->context;
+    log->count++;
+}
+
+// Test: Create a new TimingWheel
+TEST(test_timingwheel_new)
+{
+    TimingWheel *wheel = TimingWheel__new(100);
+    ASSERT_NOT_NULL(wheel, "TimingWheel should not be NULL");
+    ASSERT_EQ(wheel->now, 100, "Clock should start at the given tick");
+    ASSERT_EQ(wheel->numberOfTimers, 0, "TimingWheel should be empty");
+    TimingWheel__del(wheel);
+}
+
+// Test: Timers expire at their deadline, across levels
+TEST(test_timingwheel_expiry_order)
+{
+    TimingWheel *wheel = TimingWheel__new(0);
+    ASSERT_NOT_NULL(wheel, "TimingWheel should not be NULL");
+
+    uint64_t deadlines[6] = {5, 64, 70, 4095, 4096, 300000};
+    int ids[6] = {0, 1, 2, 3, 4, 5};
+    TimingWheelTimer timers[6];
+    ExpiryLog log = {{0}, {0}, 0, wheel};
+
+    // Schedule in reverse to show order comes from the deadlines
+    for (int i = 5; i >= 0; i--)
+    {
+        TimingWheelTimer__init(&timers[i], &ids[i]);
+        TimingWheel__schedule(wheel, &timers[i], deadlines[i]);
+    }
+
+    ASSERT_EQ(wheel->numberOfTimers, 6, "Six timers should be pending");
+
+    size_t expired = TimingWheel__advance(wheel, 4095, SIZE_MAX, sRecordExpiry, &log);
+    ASSERT_EQ(expired, 4, "Four timers should expire by tick 4095");
+    ASSERT_EQ(wheel->now, 4095, "Clock should reach the target");
+
+    expired = TimingWheel__advance(wheel, 1000000, SIZE_MAX, sRecordExpiry, &log);
+    ASSERT_EQ(expired, 2, "The remaining timers should expire");
+    ASSERT_EQ(wheel->numberOfTimers, 0, "No timer should be pending");
+
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_EQ(log.ids[i], i, "Timers should expire in deadline order");
+        ASSERT_EQ(log.ticks[i], deadlines[i], "Timers should expire exactly at their deadline");
+    }
+
+    TimingWheel__del(wheel);
+}
+
+// Test: Cancelled timers never expire
+TEST(test_timingwheel_cancel)
+{
+    TimingWheel *wheel = TimingWheel__new(0);
+    ASSERT_NOT_NULL(wheel, "TimingWheel should not be NULL");
+
+    int ids[2] = {0, 1};
+    TimingWheelTimer timers[2];
+    ExpiryLog log = {{0}, {0}, 0, wheel};
+
+    TimingWheelTimer__init(&timers[0], &ids[0]);
+    TimingWheelTimer__init(&timers[1], &ids[1]);
+    TimingWheel__schedule(wheel, &timers[0], 10);
+    TimingWheel__schedule(wheel, &timers[1], 10);
+    TimingWheel__cancel(wheel, &timers[0]);
+
+    // Rescheduling moves the timer
+    TimingWheel__schedule(wheel, &timers[1], 20);
+
+    TimingWheel__advance(wheel, 15, SIZE_MAX, sRecordExpiry, &log);
+    ASSERT_EQ(log.count, 0, "Nothing should expire by tick 15");
+
+    TimingWheel__advance(wheel, 20, SIZE_MAX, sRecordExpiry, &log);
+    ASSERT_EQ(log.count, 1, "Only the rescheduled timer should expire");
+    ASSERT_EQ(log.ids[0], 1, "The rescheduled timer should expire");
+
+    TimingWheel__del(wheel);
+}
+
+// Test: Expiry budget carries over to the next advance
+TEST(test_timingwheel_budget)
+{
+    TimingWheel *wheel = TimingWheel__new(0);
+    ASSERT_NOT_NULL(wheel, "TimingWheel should not be NULL");
+
+    int ids[10];
+    TimingWheelTimer timers[10];
+    ExpiryLog log = {{0}, {0}, 0, wheel};
+
+    for (int i = 0; i < 10; i++)
+    {
+        ids[i] = i;
+        TimingWheelTimer__init(&timers[i], &ids[i]);
+        TimingWheel__schedule(wheel, &timers[i], 100 + (i % 2));
+    }
+
+    ASSERT_EQ(TimingWheel__advance(wheel, 200, 3, sRecordExpiry, &log), 3, "Budget should cap expiries");
+    ASSERT_EQ(TimingWheel__advance(wheel, 200, 4, sRecordExpiry, &log), 4, "Budget should cap expiries");
+    ASSERT_EQ(TimingWheel__advance(wheel, 200, SIZE_MAX, sRecordExpiry, &log), 3, "Leftovers should expire");
+    ASSERT_EQ(wheel->numberOfTimers, 0, "No timer should be pending");
+    ASSERT_EQ(wheel->now, 200, "Clock should reach the target");
+
+    TimingWheel__del(wheel);
+}
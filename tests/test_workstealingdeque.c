@@ -0,0 +1,139 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <cbarroso/workstealingdeque.h>
+#include <ccauchy.h>
+
+#define STRESS_ITEMS 200000
+#define STRESS_THIEVES 3
+
+typedef struct StressContext
+{
+    WorkStealingDeque *deque;
+    _Atomic uint8_t *taken;
+    _Atomic int done;
+} StressContext;
+
+static void sTake(StressContext *context, void *item)
+{
+    atomic_fetch_add_explicit(&context->taken[(uintptr_t)item - 1], 1, memory_order_relaxed);
+}
+
+static void *sThief(void *argument)
+{
+    StressContext *context = argument;
+    void *item;
+
+    while (!atomic_load(&context->done))
+    {
+        if (WorkStealingDeque__steal(context->deque, &item) == 0)
+        {
+            sTake(context, item);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+// Test: Create a new WorkStealingDeque
+TEST(test_workstealingdeque_new)
+{
+    WorkStealingDeque *deque = WorkStealingDeque__new(100);
+    ASSERT_NOT_NULL(deque, "WorkStealingDeque should not be NULL");
+    ASSERT_EQ(atomic_load(&deque->buffer)->capacity, 128, "Capacity should round up to a power of two");
+
+    void *item;
+    ASSERT_EQ(WorkStealingDeque__pop(deque, &item), -1, "Pop on empty deque should fail");
+    ASSERT_EQ(WorkStealingDeque__steal(deque, &item), -1, "Steal on empty deque should fail");
+    ASSERT(WorkStealingDeque__new(SIZE_MAX) == NULL, "Oversized capacity should be rejected");
+    WorkStealingDeque__del(deque);
+}
+
+// Test: The owner pops LIFO, thieves steal FIFO, and the array grows
+TEST(test_workstealingdeque_order_and_growth)
+{
+    WorkStealingDeque *deque = WorkStealingDeque__new(2);
+    void *item;
+
+    for (uintptr_t i = 1; i <= 100; i++)
+    {
+        ASSERT_EQ(WorkStealingDeque__push(deque, (void *)i), 0, "Push should succeed");
+    }
+
+    ASSERT_EQ(atomic_load(&deque->buffer)->capacity, 128, "Array should double until the items fit");
+
+    WorkStealingDeque__steal(deque, &item);
+    ASSERT_EQ((uintptr_t)item, 1, "Steal should take the oldest item");
+    WorkStealingDeque__pop(deque, &item);
+    ASSERT_EQ((uintptr_t)item, 100, "Pop should take the newest item");
+
+    for (uintptr_t expected = 99; expected >= 2; expected--)
+    {
+        WorkStealingDeque__pop(deque, &item);
+        ASSERT_EQ((uintptr_t)item, expected, "Pop should be LIFO");
+    }
+
+    ASSERT_EQ(WorkStealingDeque__pop(deque, &item), -1, "Deque should be empty");
+    WorkStealingDeque__del(deque);
+}
+
+// Test: Every item is taken exactly once under heavy stealing
+TEST(test_workstealingdeque_stress)
+{
+    static _Atomic uint8_t taken[STRESS_ITEMS];
+    StressContext context;
+    pthread_t thieves[STRESS_THIEVES];
+    void *item;
+
+    context.deque = WorkStealingDeque__new(4);
+    context.taken = taken;
+    atomic_init(&context.done, 0);
+
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        atomic_init(&taken[i], 0);
+    }
+
+    for (int t = 0; t < STRESS_THIEVES; t++)
+    {
+        pthread_create(&thieves[t], NULL, sThief, &context);
+    }
+
+    // Push in bursts and pop part of each, as a fork/join worker would
+    for (uintptr_t i = 1; i <= STRESS_ITEMS; i++)
+    {
+        WorkStealingDeque__push(context.deque, (void *)i);
+
+        if (i % 3 == 0 && WorkStealingDeque__pop(context.deque, &item) == 0)
+        {
+            sTake(&context, item);
+        }
+    }
+
+    while (WorkStealingDeque__pop(context.deque, &item) == 0)
+    {
+        sTake(&context, item);
+    }
+
+    atomic_store(&context.done, 1);
+
+    for (int t = 0; t < STRESS_THIEVES; t++)
+    {
+        pthread_join(thieves[t], NULL);
+    }
+
+    int exactlyOnce = 1;
+
+    for (int i = 0; i < STRESS_ITEMS; i++)
+    {
+        exactlyOnce &= atomic_load(&taken[i]) == 1;
+    }
+
+    ASSERT(exactlyOnce, "Every item should be taken exactly once");
+    WorkStealingDeque__del(context.deque);
+}